@@ -0,0 +1,87 @@
+#include "Adafruit_NeoPixel.h"
+#include "Simulator.h"
+#include <vector>
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t pin, neoPixelType type)
+    : numLEDs(n), pin(pin), brightness(0), pixels((uint8_t *)calloc(n, 3))
+{
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel()
+{
+    free(pixels);
+}
+
+void Adafruit_NeoPixel::begin()
+{
+}
+
+void Adafruit_NeoPixel::show()
+{
+    std::vector<uint32_t> frame(numLEDs);
+    for (uint16_t i = 0; i < numLEDs; i++)
+    {
+        frame[i] = getPixelColor(i);
+    }
+    Simulator::recordFrame(frame.data(), numLEDs);
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (n >= numLEDs)
+    {
+        return;
+    }
+    if (brightness)
+    {
+        r = (r * brightness) >> 8;
+        g = (g * brightness) >> 8;
+        b = (b * brightness) >> 8;
+    }
+    uint8_t *p = &pixels[n * 3];
+    p[0] = g;
+    p[1] = r;
+    p[2] = b;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c)
+{
+    setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+}
+
+void Adafruit_NeoPixel::fill(uint32_t c, uint16_t first, uint16_t count)
+{
+    uint16_t end = (count == 0 || first + count > numLEDs) ? numLEDs : first + count;
+    for (uint16_t i = first; i < end; i++)
+    {
+        setPixelColor(i, c);
+    }
+}
+
+void Adafruit_NeoPixel::setBrightness(uint8_t b)
+{
+    // Stored as b + 1 so that 0 means "full brightness, no scaling", as upstream does
+    brightness = b + 1;
+}
+
+void Adafruit_NeoPixel::clear()
+{
+    memset(pixels, 0, numLEDs * 3);
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const
+{
+    if (n >= numLEDs)
+    {
+        return 0;
+    }
+    const uint8_t *p = &pixels[n * 3];
+    uint8_t r = p[1], g = p[0], b = p[2];
+    if (brightness)
+    {
+        r = (r << 8) / brightness;
+        g = (g << 8) / brightness;
+        b = (b << 8) / brightness;
+    }
+    return Color(r, g, b);
+}
@@ -0,0 +1,47 @@
+#ifndef ADAFRUIT_NEOPIXEL_H
+#define ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+
+#define NEO_RGB ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+typedef uint16_t neoPixelType;
+
+// Host stand-in for Adafruit_NeoPixel. Pixel data is kept in GRB order like the
+// real library; show() hands a copy of the strip to Simulator instead of a GPIO.
+class Adafruit_NeoPixel
+{
+public:
+    Adafruit_NeoPixel(uint16_t n, int16_t pin = 6, neoPixelType type = NEO_GRB + NEO_KHZ800);
+    ~Adafruit_NeoPixel();
+
+    void begin();
+    void show();
+    void setPin(int16_t p) { pin = p; }
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+    void setPixelColor(uint16_t n, uint32_t c);
+    void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0);
+    void setBrightness(uint8_t b);
+    void clear();
+    uint8_t *getPixels() const { return pixels; }
+    uint8_t getBrightness() const { return brightness - 1; }
+    int16_t getPin() const { return pin; }
+    uint16_t numPixels() const { return numLEDs; }
+    uint32_t getPixelColor(uint16_t n) const;
+    bool canShow() const { return true; }
+
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+private:
+    uint16_t numLEDs;
+    int16_t pin;
+    uint8_t brightness;
+    uint8_t *pixels;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "Arduino.h"
+#include "Simulator.h"
+#include <random>
+#include <sys/time.h>
+
+HardwareSerial Serial;
+
+static std::mt19937 rng(1);
+static long gmtOffset = 0;
+static int daylightOffset = 0;
+static bool timeConfigured = false;
+
+unsigned long millis()
+{
+    return Simulator::millis();
+}
+
+unsigned long micros()
+{
+    return Simulator::micros();
+}
+
+void delay(unsigned long ms)
+{
+    Simulator::advance(ms);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+}
+
+void yield()
+{
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+    {
+        return 0;
+    }
+    return rng() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+    {
+        return howsmall;
+    }
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    rng.seed(seed);
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    return Simulator::ambientLight();
+}
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1, const char *server2, const char *server3)
+{
+    gmtOffset = gmtOffset_sec;
+    daylightOffset = daylightOffset_sec;
+    timeConfigured = true;
+}
+
+// The RTC at millisecond resolution, for code that calls gettimeofday() directly
+extern "C" int gettimeofday(struct timeval *tv, void *tz) noexcept
+{
+    unsigned long ms = timeConfigured ? Simulator::millis() : 0;
+    tv->tv_sec = timeConfigured ? Simulator::now() : 0;
+    tv->tv_usec = (ms % 1000) * 1000;
+    return 0;
+}
+
+bool getLocalTime(struct tm *info, uint32_t ms)
+{
+    // Like the ESP32, the clock is unset until the first configTime()
+    if (!timeConfigured)
+    {
+        return false;
+    }
+    time_t local = Simulator::now() + gmtOffset + daylightOffset;
+    return gmtime_r(&local, info) != nullptr;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t pos = value.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from >= value.size())
+    {
+        return String();
+    }
+    return String(value.substr(from, to == ~0u ? std::string::npos : to - from));
+}
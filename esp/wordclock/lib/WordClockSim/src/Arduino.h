@@ -0,0 +1,132 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Minimal host replacement for the Arduino core used by the native simulator build.
+// Time is virtual: delay() returns immediately and fast-forwards millis().
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <iostream>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// 12-bit ADC; every pin reads the simulated light sensor
+uint16_t analogRead(uint8_t pin);
+
+// ESP32 core time helpers
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+class String
+{
+public:
+    String(const char *str = "") : value(str ? str : "") {}
+    String(const std::string &str) : value(str) {}
+    explicit String(char c) : value(1, c) {}
+    explicit String(int number) : value(std::to_string(number)) {}
+    explicit String(unsigned int number) : value(std::to_string(number)) {}
+    explicit String(long number) : value(std::to_string(number)) {}
+    explicit String(unsigned long number) : value(std::to_string(number)) {}
+
+    const char *c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.length(); }
+    bool equals(const String &other) const { return value == other.value; }
+    bool equals(const char *other) const { return value == other; }
+    bool equalsIgnoreCase(const String &other) const { return strcasecmp(value.c_str(), other.c_str()) == 0; }
+    bool startsWith(const String &prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    int indexOf(char c, unsigned int from = 0) const;
+    String substring(unsigned int from, unsigned int to = ~0u) const;
+
+    String &operator+=(const String &other)
+    {
+        value += other.value;
+        return *this;
+    }
+    String &operator+=(const char *other)
+    {
+        value += other;
+        return *this;
+    }
+    bool operator==(const String &other) const { return value == other.value; }
+    bool operator!=(const String &other) const { return value != other.value; }
+    bool operator==(const char *other) const { return value == other; }
+    bool operator!=(const char *other) const { return value != other; }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs.value + rhs.value); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(lhs + rhs.value); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs.value + rhs); }
+
+private:
+    std::string value;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud) {}
+
+    template <typename T>
+    size_t print(const T &value)
+    {
+        std::cout << value;
+        return 1;
+    }
+    size_t print(const String &value) { return print(value.c_str()); }
+
+    template <typename T>
+    size_t println(const T &value)
+    {
+        print(value);
+        return println();
+    }
+    size_t println()
+    {
+        std::cout << std::endl;
+        return 1;
+    }
+};
+
+extern HardwareSerial Serial;
+
+// Provided by the sketch
+void setup();
+void loop();
+
+#endif
@@ -0,0 +1,173 @@
+#include "FS.h"
+#include "Simulator.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace fs;
+
+File::File(FILE *file, const std::string &hostPath, const std::string &path)
+    : file(file), hostPath(hostPath), virtualPath(path)
+{
+}
+
+File::File(DIR *dir, const std::string &hostPath, const std::string &path)
+    : dir(dir), hostPath(hostPath), virtualPath(path)
+{
+}
+
+File::File(File &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+File &File::operator=(File &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        file = other.file;
+        dir = other.dir;
+        hostPath = std::move(other.hostPath);
+        virtualPath = std::move(other.virtualPath);
+        other.file = nullptr;
+        other.dir = nullptr;
+    }
+    return *this;
+}
+
+File::~File()
+{
+    close();
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    return file ? fwrite(buf, 1, size, file) : 0;
+}
+
+int File::available()
+{
+    return file ? (int)(size() - position()) : 0;
+}
+
+int File::read()
+{
+    return file ? fgetc(file) : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+    return file ? fread(buf, 1, size, file) : 0;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    return file && fseek(file, pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0;
+}
+
+size_t File::position() const
+{
+    return file ? ftell(file) : 0;
+}
+
+size_t File::size() const
+{
+    struct stat info;
+    if (file)
+    {
+        fflush(file);
+    }
+    return stat(hostPath.c_str(), &info) == 0 ? info.st_size : 0;
+}
+
+void File::flush()
+{
+    if (file)
+    {
+        fflush(file);
+    }
+}
+
+void File::close()
+{
+    if (file)
+    {
+        fclose(file);
+        file = nullptr;
+    }
+    if (dir)
+    {
+        closedir(dir);
+        dir = nullptr;
+    }
+}
+
+const char *File::name() const
+{
+    size_t slash = virtualPath.find_last_of('/');
+    return slash == std::string::npos ? virtualPath.c_str() : virtualPath.c_str() + slash + 1;
+}
+
+File File::openNextFile(const char *mode)
+{
+    if (!dir)
+    {
+        return File();
+    }
+    while (struct dirent *entry = readdir(dir))
+    {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+        {
+            continue;
+        }
+        std::string child = virtualPath == "/" ? "/" + std::string(entry->d_name) : virtualPath + "/" + entry->d_name;
+        FS fs;
+        return fs.open(child.c_str(), mode);
+    }
+    return File();
+}
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+    std::string hostPath = Simulator::flashPath(path);
+    struct stat info;
+    if (stat(hostPath.c_str(), &info) == 0 && S_ISDIR(info.st_mode))
+    {
+        DIR *dir = opendir(hostPath.c_str());
+        return dir ? File(dir, hostPath, path) : File();
+    }
+
+    std::string hostMode = std::string(mode) + "b";
+    if (hostMode == "rb+")
+    {
+        hostMode = "r+b";
+    }
+    FILE *file = fopen(hostPath.c_str(), hostMode.c_str());
+    return file ? File(file, hostPath, path) : File();
+}
+
+bool FS::exists(const char *path)
+{
+    struct stat info;
+    return stat(Simulator::flashPath(path).c_str(), &info) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+    return unlink(Simulator::flashPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo)
+{
+    return ::rename(Simulator::flashPath(pathFrom).c_str(), Simulator::flashPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path)
+{
+    return ::mkdir(Simulator::flashPath(path).c_str(), 0755) == 0 || exists(path);
+}
+
+bool FS::rmdir(const char *path)
+{
+    return ::rmdir(Simulator::flashPath(path).c_str()) == 0;
+}
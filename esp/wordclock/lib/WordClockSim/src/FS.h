@@ -0,0 +1,78 @@
+#ifndef FS_H
+#define FS_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <dirent.h>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// Host stand-in for fs::File, backed by a file or directory on the host
+class File : public Stream
+{
+public:
+    File() {}
+    File(FILE *file, const std::string &hostPath, const std::string &path);
+    File(DIR *dir, const std::string &hostPath, const std::string &path);
+    File(File &&other) noexcept;
+    File &operator=(File &&other) noexcept;
+    File(const File &) = delete;
+    File &operator=(const File &) = delete;
+    ~File();
+
+    size_t write(const uint8_t *buf, size_t size) override;
+    int available() override;
+    int read() override;
+    size_t read(uint8_t *buf, size_t size);
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void flush();
+    void close();
+    operator bool() const { return file != nullptr || dir != nullptr; }
+    const char *path() const { return virtualPath.c_str(); }
+    const char *name() const;
+    bool isDirectory() const { return dir != nullptr; }
+    File openNextFile(const char *mode = FILE_READ);
+
+private:
+    FILE *file = nullptr;
+    DIR *dir = nullptr;
+    std::string hostPath;
+    std::string virtualPath;
+};
+
+// Host stand-in for the flash filesystem, rooted at Simulator's flash directory
+class FS
+{
+public:
+    File open(const char *path, const char *mode = FILE_READ, bool create = false);
+    File open(const String &path, const char *mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *pathFrom, const char *pathTo);
+    bool mkdir(const char *path);
+    bool rmdir(const char *path);
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef HTTPCLIENT_H
+#define HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include <map>
+#include <string>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_NO_STREAM (-8)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum
+{
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_NOT_FOUND = 404
+} t_http_codes;
+
+// Host stand-in for HTTPClient: GET serves the file named by the last URL path
+// segment from Simulator's HTTP root directory. Responses carry an ETag and
+// Last-Modified, and a matching If-None-Match is answered with 304.
+class HTTPClient
+{
+public:
+    bool begin(const char *url);
+    bool begin(const String &url) { return begin(url.c_str()); }
+    void addHeader(const String &name, const String &value);
+    int GET();
+    int getSize() const { return size; }
+    void collectHeaders(const char *headerKeys[], const size_t headerKeysCount) {}
+    String header(const char *name);
+    WiFiClient *getStreamPtr() { return &client; }
+    WiFiClient &getStream() { return client; }
+    int writeToStream(Stream *stream);
+    bool connected() { return client.connected(); }
+    void end();
+
+private:
+    String url;
+    int size = -1;
+    bool chunked = false;
+    bool dropped = false;
+    std::vector<uint8_t> content;
+    std::map<std::string, std::string> requestHeaders;
+    std::string etag;
+    std::string lastModified;
+    WiFiClient client;
+
+    static std::vector<uint8_t> encodeChunked(const std::vector<uint8_t> &body);
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include "LittleFS.h"
+#include "Simulator.h"
+#include <sys/stat.h>
+
+LittleFSFS LittleFS;
+
+static size_t directorySize(fs::File dir)
+{
+    size_t total = 0;
+    while (fs::File entry = dir.openNextFile())
+    {
+        total += entry.isDirectory() ? directorySize(std::move(entry)) : entry.size();
+    }
+    return total;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel)
+{
+    std::string root = Simulator::flashPath("/");
+    // Create every missing component of the host directory
+    for (size_t slash = root.find('/', 1); slash != std::string::npos; slash = root.find('/', slash + 1))
+    {
+        ::mkdir(root.substr(0, slash).c_str(), 0755);
+    }
+    struct stat info;
+    return stat(root.c_str(), &info) == 0;
+}
+
+bool LittleFSFS::format()
+{
+    return true;
+}
+
+size_t LittleFSFS::usedBytes()
+{
+    return directorySize(open("/"));
+}
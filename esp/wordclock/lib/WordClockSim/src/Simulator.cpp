@@ -0,0 +1,178 @@
+#include "Simulator.h"
+#include <chrono>
+#include <math.h>
+#include <random>
+
+static const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+
+uint64_t Simulator::skippedUs = 0;
+time_t Simulator::epoch = time(nullptr);
+std::vector<Simulator::Frame> Simulator::recordedFrames;
+unsigned long Simulator::shows = 0;
+size_t Simulator::frameLimit = 100000;
+std::string Simulator::httpRoot = "gifs";
+std::string Simulator::flashRoot = ".pio/sim_flash";
+unsigned long Simulator::httpFirstByteMs = 0;
+unsigned long Simulator::httpRate = 0;
+bool Simulator::httpChunkedEncoding = false;
+bool Simulator::httpNoLength = false;
+size_t Simulator::httpDropBytes = 0;
+int Simulator::ambientLevel = -1;
+
+unsigned long Simulator::micros()
+{
+    uint64_t realUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+    return (unsigned long)(realUs + skippedUs);
+}
+
+unsigned long Simulator::millis()
+{
+    return micros() / 1000;
+}
+
+void Simulator::advance(unsigned long ms)
+{
+    skippedUs += (uint64_t)ms * 1000;
+}
+
+void Simulator::setEpoch(time_t newEpoch)
+{
+    epoch = newEpoch - (time_t)(millis() / 1000);
+}
+
+time_t Simulator::now()
+{
+    return epoch + (time_t)(millis() / 1000);
+}
+
+void Simulator::recordFrame(const uint32_t *pixels, uint16_t count)
+{
+    shows++;
+    if (recordedFrames.size() < frameLimit)
+    {
+        recordedFrames.push_back({millis(), std::vector<uint32_t>(pixels, pixels + count)});
+    }
+}
+
+const std::vector<Simulator::Frame> &Simulator::frames()
+{
+    return recordedFrames;
+}
+
+unsigned long Simulator::showCount()
+{
+    return shows;
+}
+
+void Simulator::clearFrames()
+{
+    recordedFrames.clear();
+    shows = 0;
+}
+
+void Simulator::setFrameLimit(size_t limit)
+{
+    frameLimit = limit;
+}
+
+void Simulator::setHttpRoot(const std::string &root)
+{
+    httpRoot = root;
+}
+
+std::string Simulator::httpPath(const char *url)
+{
+    std::string path(url);
+    size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos)
+    {
+        path = path.substr(slash + 1);
+    }
+    return httpRoot + "/" + path;
+}
+
+void Simulator::setFlashRoot(const std::string &root)
+{
+    flashRoot = root;
+}
+
+std::string Simulator::flashPath(const char *path)
+{
+    return flashRoot + (path[0] == '/' ? "" : "/") + path;
+}
+
+void Simulator::setHttpLatency(unsigned long firstByteMs)
+{
+    httpFirstByteMs = firstByteMs;
+}
+
+void Simulator::setHttpBytesPerMs(unsigned long bytesPerMs)
+{
+    httpRate = bytesPerMs;
+}
+
+void Simulator::setHttpChunked(bool chunked)
+{
+    httpChunkedEncoding = chunked;
+}
+
+void Simulator::setHttpCloseDelimited(bool closeDelimited)
+{
+    httpNoLength = closeDelimited;
+}
+
+void Simulator::setHttpDropAfter(size_t bytes)
+{
+    httpDropBytes = bytes;
+}
+
+unsigned long Simulator::httpLatency()
+{
+    return httpFirstByteMs;
+}
+
+unsigned long Simulator::httpBytesPerMs()
+{
+    return httpRate;
+}
+
+bool Simulator::httpChunked()
+{
+    return httpChunkedEncoding;
+}
+
+bool Simulator::httpCloseDelimited()
+{
+    return httpNoLength;
+}
+
+size_t Simulator::httpDropAfter()
+{
+    return httpDropBytes;
+}
+
+void Simulator::setAmbientLight(int level)
+{
+    ambientLevel = level;
+}
+
+uint16_t Simulator::ambientLight()
+{
+    if (ambientLevel >= 0)
+    {
+        return ambientLevel > 4095 ? 4095 : ambientLevel;
+    }
+
+    // Daylight from 06:00 to 18:00 UTC peaking at noon, a dim lamp otherwise,
+    // and the odd spike for the median filter.
+    // Its own generator, so sampling doesn't change which GIFs the sketch picks.
+    static std::mt19937 noise(7);
+    double hour = (now() % 86400) / 3600.0;
+    double daylight = hour > 6 && hour < 18 ? sin((hour - 6) * M_PI / 12) : 0;
+    int level = 80 + (int)(daylight * 3800) + (int)(noise() % 61) - 30;
+    if (noise() % 50 == 0)
+    {
+        level += 1500; // car headlights sweeping the room
+    }
+    return level < 0 ? 0 : (level > 4095 ? 4095 : level);
+}
@@ -0,0 +1,79 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdint.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+// Shared state of the host simulator: virtual clock, recorded LED frames and
+// the directory HTTPClient serves downloads from.
+class Simulator
+{
+public:
+    struct Frame
+    {
+        unsigned long timeMs;
+        std::vector<uint32_t> pixels;
+    };
+
+    // Virtual clock: real elapsed time plus everything skipped by delay()
+    static unsigned long millis();
+    static unsigned long micros();
+    static void advance(unsigned long ms);
+
+    // Wall clock reported through getLocalTime()
+    static void setEpoch(time_t epoch);
+    static time_t now();
+
+    // Every Adafruit_NeoPixel::show() lands here
+    static void recordFrame(const uint32_t *pixels, uint16_t count);
+    static const std::vector<Frame> &frames();
+    static unsigned long showCount();
+    static void clearFrames();
+    static void setFrameLimit(size_t limit);
+
+    // Root directory HTTPClient maps URL file names onto
+    static void setHttpRoot(const std::string &root);
+    static std::string httpPath(const char *url);
+
+    // Host directory backing the LittleFS partition
+    static void setFlashRoot(const std::string &root);
+    static std::string flashPath(const char *path);
+
+    // Network conditions for simulated downloads (0 bytes/ms = unlimited,
+    // dropping after 0 bytes = never)
+    static void setHttpLatency(unsigned long firstByteMs);
+    static void setHttpBytesPerMs(unsigned long bytesPerMs);
+    static void setHttpChunked(bool chunked);
+    // Plain bodies without a Content-Length, ended by closing the connection
+    static void setHttpCloseDelimited(bool closeDelimited);
+    static void setHttpDropAfter(size_t bytes);
+    static unsigned long httpLatency();
+    static unsigned long httpBytesPerMs();
+    static bool httpChunked();
+    static bool httpCloseDelimited();
+    static size_t httpDropAfter();
+
+    // Light sensor on the ADC: a fixed 12-bit reading, or with a negative level
+    // a day/night curve over the wall clock with a little noise
+    static void setAmbientLight(int level);
+    static uint16_t ambientLight();
+
+private:
+    static uint64_t skippedUs;
+    static time_t epoch;
+    static std::vector<Frame> recordedFrames;
+    static unsigned long shows;
+    static size_t frameLimit;
+    static std::string httpRoot;
+    static std::string flashRoot;
+    static unsigned long httpFirstByteMs;
+    static unsigned long httpRate;
+    static bool httpChunkedEncoding;
+    static bool httpNoLength;
+    static size_t httpDropBytes;
+    static int ambientLevel;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *passphrase)
+{
+    connectionStatus = WL_CONNECTED;
+    return connectionStatus;
+}
+
+bool WiFiClass::disconnect(bool wifioff)
+{
+    connectionStatus = WL_DISCONNECTED;
+    return true;
+}
+
+bool WiFiClass::reconnect()
+{
+    connectionStatus = WL_CONNECTED;
+    return true;
+}
+
+void WiFiClient::setBody(std::vector<uint8_t> &&data, unsigned long newFirstByteAt, unsigned long newBytesPerMs)
+{
+    body = std::move(data);
+    position = 0;
+    firstByteAt = newFirstByteAt;
+    bytesPerMs = newBytesPerMs;
+}
+
+size_t WiFiClient::arrived()
+{
+    long sinceFirstByte = (long)(millis() - firstByteAt);
+    if (sinceFirstByte < 0)
+    {
+        return 0;
+    }
+    if (bytesPerMs == 0)
+    {
+        return body.size();
+    }
+    size_t count = (size_t)(sinceFirstByte + 1) * bytesPerMs;
+    return count < body.size() ? count : body.size();
+}
+
+int WiFiClient::available()
+{
+    return arrived() - position;
+}
+
+int WiFiClient::read()
+{
+    if (position >= arrived())
+    {
+        return -1;
+    }
+    return body[position++];
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size)
+{
+    size_t count = arrived() - position;
+    if (count > size)
+    {
+        count = size;
+    }
+    memcpy(buf, body.data() + position, count);
+    position += count;
+    return count;
+}
+
+size_t WiFiClient::readBytes(uint8_t *buf, size_t length)
+{
+    return read(buf, length);
+}
+
+uint8_t WiFiClient::connected()
+{
+    return position < body.size();
+}
+
+void WiFiClient::stop()
+{
+    body.clear();
+    position = 0;
+}
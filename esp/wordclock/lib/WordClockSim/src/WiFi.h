@@ -0,0 +1,57 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <Arduino.h>
+#include <vector>
+
+typedef enum
+{
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+// Host stand-in for the ESP32 WiFi singleton: always connects immediately
+class WiFiClass
+{
+public:
+    wl_status_t begin(const char *ssid, const char *passphrase = nullptr);
+    wl_status_t status() const { return connectionStatus; }
+    bool isConnected() const { return connectionStatus == WL_CONNECTED; }
+    bool disconnect(bool wifioff = false);
+    bool reconnect();
+
+private:
+    wl_status_t connectionStatus = WL_DISCONNECTED;
+};
+
+extern WiFiClass WiFi;
+
+// Socket stand-in that replays an in-memory response body. Bytes become
+// available from firstByteAt onwards at bytesPerMs (0 = all at once).
+class WiFiClient : public Stream
+{
+public:
+    void setBody(std::vector<uint8_t> &&data, unsigned long firstByteAt = 0, unsigned long bytesPerMs = 0);
+    int available() override;
+    int read() override;
+    int read(uint8_t *buf, size_t size);
+    size_t write(const uint8_t *buf, size_t size) override { return size; }
+    size_t readBytes(uint8_t *buf, size_t length);
+    uint8_t connected();
+    void stop();
+    void setTimeout(unsigned long timeoutMs) {}
+
+private:
+    std::vector<uint8_t> body;
+    size_t position = 0;
+    unsigned long firstByteAt = 0;
+    unsigned long bytesPerMs = 0;
+
+    size_t arrived();
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Fallback configuration for the native simulator build. A src/config.h, when
+// present, takes precedence because the sketch includes it with quotes.
+#define WIFI_SSID "simulator"
+#define WIFI_PASSWORD ""
+#define USE_SERIAL 1
+#define LED_PIN 13
+// Reads the simulated light sensor; build with -DLDR_PIN=-1 -DDIM_AT_NIGHT=1 for
+// the dimming schedule, or -DLDR_PIN=-1 alone for a fixed brightness
+#ifndef LDR_PIN
+#define LDR_PIN 0
+#endif
+
+#define GMT_OFFSET_SEC 0
+#define DAYLIGHT_OFFSET_SEC 0
+
+#endif
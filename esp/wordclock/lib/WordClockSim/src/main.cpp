@@ -0,0 +1,81 @@
+#include <Arduino.h>
+#include <stdio.h>
+#include "Simulator.h"
+
+// Entry point of the native simulator: runs the sketch's setup()/loop() against
+// the virtual clock and reports what would have been pushed to the LED strip.
+//
+//   program [--seconds N] [--epoch UNIX_TIME] [--http-root DIR] [--seed N] [--dump FILE]
+//           [--http-latency MS] [--http-rate BYTES_PER_MS] [--http-chunked 1] [--flash-root DIR]
+//           [--ldr LEVEL]
+//
+// Left out of `pio test` builds, where each test under test/ brings its own main().
+#ifndef PIO_UNIT_TESTING
+
+static void dumpFrames(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return;
+    }
+    for (const Simulator::Frame &frame : Simulator::frames())
+    {
+        fprintf(file, "%lu", frame.timeMs);
+        for (uint32_t pixel : frame.pixels)
+        {
+            fprintf(file, " %06x", (unsigned)pixel);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long seconds = 3600;
+    const char *dumpPath = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--seconds") == 0)
+            seconds = strtoul(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--epoch") == 0)
+            Simulator::setEpoch((time_t)strtoll(argv[i + 1], nullptr, 10));
+        else if (strcmp(argv[i], "--http-root") == 0)
+            Simulator::setHttpRoot(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)
+            randomSeed(strtoul(argv[i + 1], nullptr, 10));
+        else if (strcmp(argv[i], "--http-latency") == 0)
+            Simulator::setHttpLatency(strtoul(argv[i + 1], nullptr, 10));
+        else if (strcmp(argv[i], "--http-rate") == 0)
+            Simulator::setHttpBytesPerMs(strtoul(argv[i + 1], nullptr, 10));
+        else if (strcmp(argv[i], "--http-chunked") == 0)
+            Simulator::setHttpChunked(atoi(argv[i + 1]) != 0);
+        else if (strcmp(argv[i], "--flash-root") == 0)
+            Simulator::setFlashRoot(argv[i + 1]);
+        else if (strcmp(argv[i], "--ldr") == 0)
+            Simulator::setAmbientLight(atoi(argv[i + 1]));
+        else if (strcmp(argv[i], "--dump") == 0)
+            dumpPath = argv[i + 1];
+    }
+
+    unsigned long endMs = millis() + seconds * 1000;
+    setup();
+    while (millis() < endMs)
+    {
+        loop();
+    }
+
+    printf("simulated %lu s: %lu show() calls, %zu frames recorded\n",
+           seconds, Simulator::showCount(), Simulator::frames().size());
+
+    if (dumpPath != nullptr)
+    {
+        dumpFrames(dumpPath);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+// Something that owns the display for a while and is advanced one frame at a
+// time by FrameScheduler instead of blocking in its own loop.
+class Animation
+{
+public:
+    virtual ~Animation() {}
+
+    // Renders a frame if one is due at `now`; must return quickly
+    virtual void tick(unsigned long now) = 0;
+    virtual bool done() const = 0;
+    // When the next frame is due, so the scheduler can sleep until then
+    virtual unsigned long nextDeadline() const = 0;
+};
+
+#endif
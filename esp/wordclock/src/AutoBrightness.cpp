@@ -0,0 +1,174 @@
+#include "AutoBrightness.h"
+#include "SerialHelper.h"
+
+// Dimming schedule for clocks without a sensor: level 0 is minBrightness,
+// 255 is maxBrightness, interpolated linearly between points
+struct SchedulePoint
+{
+    uint16_t minute; // minute of the day
+    uint8_t level;
+};
+
+constexpr SchedulePoint DIMMING_SCHEDULE[] = {
+    {0, 0},
+    {6 * 60, 0},
+    {8 * 60, 255},
+    {20 * 60, 255},
+    {22 * 60 + 30, 0},
+    {24 * 60, 0}};
+constexpr uint8_t SCHEDULE_POINTS = sizeof(DIMMING_SCHEDULE) / sizeof(DIMMING_SCHEDULE[0]);
+
+constexpr bool scheduleCoversDay(uint8_t i = 1)
+{
+    return i == SCHEDULE_POINTS
+               ? DIMMING_SCHEDULE[0].minute == 0 && DIMMING_SCHEDULE[SCHEDULE_POINTS - 1].minute == 24 * 60
+               : DIMMING_SCHEDULE[i - 1].minute < DIMMING_SCHEDULE[i].minute && scheduleCoversDay(i + 1);
+}
+static_assert(scheduleCoversDay(), "Dimming schedule must run from 00:00 to 24:00 in order");
+
+AutoBrightness::AutoBrightness(ClockDisplayHAL *hal, WiFiTimeManager *networkManager, FrameScheduler *scheduler, int8_t ldrPin, bool dimAtNight, uint8_t minBrightness, uint8_t maxBrightness)
+    : hal(hal), networkManager(networkManager), scheduler(scheduler), ldrPin(ldrPin), dimAtNight(dimAtNight), minBrightness(minBrightness), maxBrightness(maxBrightness), target(0), hasTarget(false), nextSample(0), lastRamp(0), samples{}, sampleIndex(0), filtered(0) {}
+
+void AutoBrightness::begin()
+{
+    target = hal->getBrightness();
+    nextSample = millis();
+    SERIAL_PRINTLN(ldrPin >= 0 ? "Auto brightness: light sensor" : dimAtNight ? "Auto brightness: dimming schedule" : "Auto brightness: off");
+}
+
+void AutoBrightness::update(unsigned long now)
+{
+    if (ldrPin < 0 && !dimAtNight)
+    {
+        return;
+    }
+    if ((long)(now - nextSample) >= 0)
+    {
+        int candidate = ldrPin >= 0 ? sensorTarget() : scheduleTarget();
+        if (candidate >= 0)
+        {
+            acceptTarget(candidate);
+        }
+        // Until the clock is set the schedule is polled like the sensor
+        nextSample = now + (ldrPin < 0 && candidate >= 0 ? SCHEDULE_MS : SAMPLE_MS);
+    }
+
+    ramp(now);
+    scheduler->setIdleDeadline(hal->getBrightness() != target ? lastRamp + RAMP_MS : nextSample);
+}
+
+int AutoBrightness::readSensor()
+{
+    int level = analogRead(ldrPin);
+    if (!hasTarget)
+    {
+        for (int &sample : samples)
+        {
+            sample = level;
+        }
+    }
+    samples[sampleIndex] = level;
+    sampleIndex = (sampleIndex + 1) % MEDIAN_SAMPLES;
+
+    // Insertion sort of a copy; five elements are cheaper sorted than selected
+    int sorted[MEDIAN_SAMPLES];
+    for (uint8_t i = 0; i < MEDIAN_SAMPLES; ++i)
+    {
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > samples[i]; --j)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = samples[i];
+    }
+    return sorted[MEDIAN_SAMPLES / 2];
+}
+
+int AutoBrightness::sensorTarget()
+{
+    int level = readSensor();
+    if (!hasTarget)
+    {
+        filtered = level << FILTER_SHIFT;
+    }
+    filtered += level - (filtered >> FILTER_SHIFT);
+
+    int ambient = getAmbientLevel();
+    ambient = ambient < LDR_DARK ? LDR_DARK : (ambient > LDR_BRIGHT ? LDR_BRIGHT : ambient);
+    return minBrightness + (ambient - LDR_DARK) * (maxBrightness - minBrightness) / (LDR_BRIGHT - LDR_DARK);
+}
+
+int AutoBrightness::scheduleTarget()
+{
+    struct tm timeinfo;
+    if (!networkManager->getTime(timeinfo))
+    {
+        return -1;
+    }
+
+    uint16_t minute = timeinfo.tm_hour * 60 + timeinfo.tm_min;
+    uint8_t i = 1;
+    while (DIMMING_SCHEDULE[i].minute <= minute && i < SCHEDULE_POINTS - 1)
+    {
+        ++i;
+    }
+    const SchedulePoint &from = DIMMING_SCHEDULE[i - 1];
+    const SchedulePoint &to = DIMMING_SCHEDULE[i];
+    int level = from.level + (to.level - from.level) * (minute - from.minute) / (to.minute - from.minute);
+    return minBrightness + level * (maxBrightness - minBrightness) / 255;
+}
+
+void AutoBrightness::acceptTarget(uint8_t candidate)
+{
+    // The ends of the range are always reachable, whatever the band
+    int delta = candidate > target ? candidate - target : target - candidate;
+    bool atLimit = candidate == minBrightness || candidate == maxBrightness;
+    if (hasTarget && (delta == 0 || (delta <= HYSTERESIS && !atLimit)))
+    {
+        return;
+    }
+    hasTarget = true;
+    target = candidate;
+
+    SERIAL_PRINT("Brightness target ");
+    SERIAL_PRINT((int)target);
+    SERIAL_PRINT(", last frame ~");
+    SERIAL_PRINT(hal->getEstimatedCurrentMa());
+    SERIAL_PRINTLN(" mA");
+}
+
+void AutoBrightness::ramp(unsigned long now)
+{
+    uint8_t current = hal->getBrightness();
+    if (current == target || now - lastRamp < RAMP_MS)
+    {
+        return;
+    }
+    lastRamp = now;
+
+    // Eighth of the remaining distance per step: quick at first, gentle at the end
+    int delta = target - current;
+    int step = delta / 8;
+    if (step == 0)
+    {
+        step = delta > 0 ? 1 : -1;
+    }
+    hal->setBrightness(current + step);
+
+    // An animation pushes its next frame anyway; an idle display needs the push here,
+    // rounded since the frame then stays up until the next step
+    if (!scheduler->isAnimating())
+    {
+        hal->showStill();
+    }
+}
+
+uint8_t AutoBrightness::getTarget() const
+{
+    return target;
+}
+
+int AutoBrightness::getAmbientLevel() const
+{
+    return ldrPin >= 0 ? filtered >> FILTER_SHIFT : -1;
+}
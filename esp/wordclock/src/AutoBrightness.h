@@ -0,0 +1,67 @@
+#ifndef AUTO_BRIGHTNESS_H
+#define AUTO_BRIGHTNESS_H
+
+#include <Arduino.h>
+#include "ClockDisplayHAL.h"
+#include "NetworkManager.h"
+#include "FrameScheduler.h"
+
+// Follows the room light with an LDR on an ADC pin. Without one (ldrPin < 0)
+// the brightness stays where the HAL started, unless dimAtNight selects a
+// time-of-day dimming schedule instead. Readings go through a median of
+// five, to drop spikes up to two samples long, and an IIR low-pass. A new target is only
+// taken when it moves by more than the hysteresis band, and the HAL brightness
+// ramps towards it so changes never show as a jump.
+class AutoBrightness
+{
+public:
+    // The LDR is expected on the high side of a divider: brighter rooms read higher
+    static const int ADC_MAX = 4095;
+    static const int LDR_DARK = 150;
+    static const int LDR_BRIGHT = 3000;
+
+    AutoBrightness(ClockDisplayHAL *hal, WiFiTimeManager *networkManager, FrameScheduler *scheduler, int8_t ldrPin, bool dimAtNight, uint8_t minBrightness, uint8_t maxBrightness);
+
+    void begin();
+    // Call on every wake; samples when due, steps the ramp and sets the next idle deadline
+    void update(unsigned long now);
+
+    uint8_t getTarget() const;
+    // Filtered sensor level 0..ADC_MAX, or -1 without a sensor
+    int getAmbientLevel() const;
+
+private:
+    // The sensor is read once a second; the schedule only needs a look once a minute
+    static const unsigned long SAMPLE_MS = 1000;
+    static const unsigned long SCHEDULE_MS = 60000;
+    static const unsigned long RAMP_MS = 40;
+    static const uint8_t HYSTERESIS = 6;
+    static const uint8_t MEDIAN_SAMPLES = 5;
+    // IIR weight of a new reading, as a shift: 1/8
+    static const uint8_t FILTER_SHIFT = 3;
+
+    ClockDisplayHAL *hal;
+    WiFiTimeManager *networkManager;
+    FrameScheduler *scheduler;
+    int8_t ldrPin;
+    bool dimAtNight;
+    uint8_t minBrightness;
+    uint8_t maxBrightness;
+
+    uint8_t target;
+    bool hasTarget;
+    unsigned long nextSample;
+    unsigned long lastRamp;
+
+    int samples[MEDIAN_SAMPLES];
+    uint8_t sampleIndex;
+    int32_t filtered; // level << FILTER_SHIFT
+
+    int readSensor();
+    int sensorTarget();
+    int scheduleTarget();
+    void acceptTarget(uint8_t candidate);
+    void ramp(unsigned long now);
+};
+
+#endif
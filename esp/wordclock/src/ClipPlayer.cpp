@@ -0,0 +1,84 @@
+#include "ClipPlayer.h"
+
+ClipPlayer::ClipPlayer(ClockDisplayHAL *clockDisplayHAL)
+    : clockDisplayHAL(clockDisplayHAL), canvas{}, playing(false), startTime(0), durationMs(0)
+{
+}
+
+GifClip &ClipPlayer::getClip()
+{
+    return clip;
+}
+
+bool ClipPlayer::begin(unsigned long newDurationMs)
+{
+    if (!clip.isValid())
+    {
+        return false;
+    }
+
+    clip.rewind();
+    playing = true;
+    durationMs = newDurationMs;
+    startTime = millis();
+    pacer.start(startTime);
+    return true;
+}
+
+void ClipPlayer::tick(unsigned long now)
+{
+    if (!playing)
+    {
+        return;
+    }
+
+    if (now - startTime >= durationMs)
+    {
+        playing = false;
+        pacer.logStats("GIF clip");
+        return;
+    }
+
+    if (!pacer.due(now))
+    {
+        return;
+    }
+
+    // Deltas build on the previous frame, so late frames are applied but not shown
+    uint16_t frameDelayMs = applyNextFrame();
+    while (pacer.late(now, frameDelayMs))
+    {
+        pacer.drop(frameDelayMs);
+        frameDelayMs = applyNextFrame();
+    }
+
+    clockDisplayHAL->blitFrame(canvas);
+    clockDisplayHAL->show();
+    pacer.present(now, frameDelayMs);
+}
+
+uint16_t ClipPlayer::applyNextFrame()
+{
+    uint16_t frameDelayMs = 0;
+    if (!clip.nextFrame(canvas, frameDelayMs))
+    {
+        clip.rewind();
+        clip.nextFrame(canvas, frameDelayMs);
+    }
+    return FramePacer::normalizeDelay(frameDelayMs);
+}
+
+bool ClipPlayer::done() const
+{
+    return !playing;
+}
+
+unsigned long ClipPlayer::nextDeadline() const
+{
+    return pacer.nextDeadline();
+}
+
+const FramePacingStats &ClipPlayer::getPacingStats() const
+{
+    return pacer.getStats();
+}
@@ -0,0 +1,36 @@
+#ifndef CLIP_PLAYER_H
+#define CLIP_PLAYER_H
+
+#include <Arduino.h>
+#include "Animation.h"
+#include "ClockDisplayHAL.h"
+#include "GifClip.h"
+#include "FramePacer.h"
+
+// Plays a pre-decoded GifClip, looping it until the duration has passed
+class ClipPlayer : public Animation
+{
+public:
+    ClipPlayer(ClockDisplayHAL *clockDisplayHAL);
+    GifClip &getClip();
+
+    bool begin(unsigned long durationMs);
+    void tick(unsigned long now) override;
+    bool done() const override;
+    unsigned long nextDeadline() const override;
+    const FramePacingStats &getPacingStats() const;
+
+private:
+    ClockDisplayHAL *clockDisplayHAL;
+    GifClip clip;
+    uint8_t canvas[GifClip::PIXELS * 3];
+
+    bool playing;
+    unsigned long startTime;
+    unsigned long durationMs;
+    FramePacer pacer;
+
+    uint16_t applyNextFrame();
+};
+
+#endif
@@ -1,98 +1,336 @@
 #include "ClockDisplayHAL.h"
+#include "ProfileClock.h"
+#include "SerialHelper.h"
+#include "FixedMath.h"
+#include "GammaTable.h"
+#include <assert.h>
 
-ClockDisplayHAL::WordMapping const ClockDisplayHAL::WORDS_TO_LEDS[] = {
-    {"HOUR_1", 20, 22},
-    {"HOUR_2", 45, 47},
-    {"HOUR_3", 15, 19},
-    {"HOUR_4", 67, 70},
-    {"HOUR_5", 40, 43},
-    {"HOUR_6", 12, 14},
-    {"HOUR_7", 55, 59},
-    {"HOUR_8", 31, 35},
-    {"HOUR_9", 36, 39},
-    {"HOUR_10", 9, 11},
-    {"HOUR_11", 24, 29},
-    {"HOUR_12", 48, 53},
-    {"OCLOCK", 0, 5},
-    {"PAST", 60, 63},
-    {"TO", 63, 64},
-    {"MINUTES", 77, 83},
-    {"THIRTY", 84, 89},
-    {"TWENTY", 102, 107},
-    {"TWENTYFIVE", 98, 107},
-    {"FIVE", 98, 101},
-    {"TEN", 91, 93},
-    {"FIFTEEN", 110, 116},
-    {"IS", 127, 128},
-    {"IT", 130, 131}};
-
-ClockDisplayHAL::ClockDisplayHAL(uint8_t pin, uint8_t brightness)
-    : pixels(NUM_LEDS, pin, NEO_GRB + NEO_KHZ800), brightness(brightness)
+ClockDisplayHAL::ClockDisplayHAL(uint8_t pin, uint8_t brightness, LedBackend backend)
+    : pixels(NUM_LEDS, pin, NEO_GRB + NEO_KHZ800), brightness(brightness), backend(backend), rmtOutput(pin, NUM_LEDS), layers{}, layerMasks{}, layerAlpha{}, latched{}, outputLut{}, output{}, residual{}, dithering(true), outputStale(false), outputSum(0), dirty(false), framesSent(0), framesSkipped(0), lastShowNs(0)
 {
+    memset(layerAlpha, 255, sizeof(layerAlpha));
 }
 
 void ClockDisplayHAL::setup()
 {
     pixels.setBrightness(255);
     pixels.begin();
-    pixels.show();
+    if (backend == LedBackend::RMT && !rmtOutput.begin())
+    {
+        SERIAL_PRINTLN("RMT output unavailable, using NeoPixel");
+        backend = LedBackend::NEOPIXEL;
+    }
+    buildOutputLut();
+    pixels.clear();
+    memset(latched, 0, sizeof(latched));
+    push();
+    dirty = false;
+}
+
+void ClockDisplayHAL::displayWord(WordId word, uint32_t color)
+{
+    const WordSpan &span = WORD_SPANS[static_cast<uint8_t>(word)];
+    dirty = true;
+    pixels.fill(color, span.start, span.end - span.start + 1);
 }
 
-void ClockDisplayHAL::displayWord(const String &word, uint32_t color)
+void ClockDisplayHAL::displayMask(const LedMask &mask, uint32_t color)
 {
-    for (auto mapping : WORDS_TO_LEDS)
+    dirty = true;
+    for (uint8_t w = 0; w < LedMask::WORDS; ++w)
     {
-        if (word.equals(mapping.word))
+        uint32_t bits = mask.bits[w];
+        while (bits)
         {
-            for (uint8_t i = mapping.start; i <= mapping.end; ++i)
-            {
-                pixels.setPixelColor(i, color);
-            }
-            break;
+            uint8_t bit = __builtin_ctz(bits);
+            pixels.setPixelColor((w << 5) + bit, color);
+            bits &= bits - 1;
         }
     }
 }
 
-uint16_t ClockDisplayHAL::cartesianToWordClockLEDStripIndex(uint8_t x, uint8_t y)
+void ClockDisplayHAL::displayPhrase(const WordId *words, uint8_t count, const uint32_t *colors)
 {
-    uint16_t row_index;
-    uint16_t index;
-
-    if (y % 2 == 0)
+    for (uint8_t i = 0; i < count; ++i)
     {
-        row_index = NUM_LEDS - (y * WIDTH);
-        index = row_index - (x + 1);
+        displayWord(words[i], colors[i]);
     }
-    else
+}
+
+void ClockDisplayHAL::displayPhrase(const WordId *words, uint8_t count, uint32_t color)
+{
+    displayMask(phraseMask(words, count), color);
+}
+
+bool ClockDisplayHAL::inBounds(uint8_t x, uint8_t y)
+{
+#ifdef HAL_BOUNDS_ASSERT
+    assert(x < WIDTH && y < HEIGHT);
+#endif
+    return x < WIDTH && y < HEIGHT;
+}
+
+void ClockDisplayHAL::setPixel(uint8_t x, uint8_t y, uint32_t color)
+{
+    if (!inBounds(x, y))
     {
-        row_index = NUM_LEDS - ((y + 1) * WIDTH);
-        index = row_index + x;
+        return;
     }
+    pixels.setPixelColor(GRID_TO_LED.index[y][x], color);
+    dirty = true;
+}
 
-    if (index < 0 || index >= NUM_LEDS)
+void ClockDisplayHAL::blitRow(uint8_t y, const uint8_t *rgb, uint8_t x, uint8_t count)
+{
+    if (!inBounds(x, y))
+    {
+        return;
+    }
+#ifdef HAL_BOUNDS_ASSERT
+    assert(x + count <= WIDTH);
+#endif
+    if (x + count > WIDTH)
     {
-        return 0;
+        count = WIDTH - x;
     }
 
-    return index;
+    // setup() leaves the strip at full brightness, so the buffer holds colours
+    // unscaled. Neighbouring cells are adjacent on the strip, walking forwards
+    // or backwards depending on the row.
+    uint8_t *pixel = pixels.getPixels() + GRID_TO_LED.index[y][x] * 3;
+    int step = y % 2 == 0 ? -3 : 3;
+    for (uint8_t i = 0; i < count; ++i, rgb += 3, pixel += step)
+    {
+        pixel[OFFSET_R] = rgb[0];
+        pixel[OFFSET_G] = rgb[1];
+        pixel[OFFSET_B] = rgb[2];
+    }
+    dirty = true;
 }
 
-void ClockDisplayHAL::setPixel(uint8_t x, uint8_t y, uint32_t color)
+void ClockDisplayHAL::blitFrame(const uint8_t *rgb)
 {
-    uint16_t index = cartesianToWordClockLEDStripIndex(x, y);
-    pixels.setPixelColor(index, color);
+    for (uint8_t y = 0; y < HEIGHT; ++y, rgb += WIDTH * 3)
+    {
+        blitRow(y, rgb);
+    }
 }
 
 void ClockDisplayHAL::clearPixels(bool show)
 {
     pixels.clear();
+    dirty = true;
     if (show)
     {
-        pixels.show();
+        this->show();
     }
 }
 
+uint8_t *ClockDisplayHAL::layerPixels(Layer layer)
+{
+    return layers[static_cast<uint8_t>(layer)];
+}
+
+LedMask &ClockDisplayHAL::layerMask(Layer layer)
+{
+    return layerMasks[static_cast<uint8_t>(layer)];
+}
+
+void ClockDisplayHAL::setLayerAlpha(Layer layer, uint8_t alpha)
+{
+    layerAlpha[static_cast<uint8_t>(layer)] = alpha;
+}
+
+void ClockDisplayHAL::clearLayer(Layer layer)
+{
+    memset(layerPixels(layer), 0, NUM_LEDS * 3);
+    layerMask(layer) = LedMask{};
+}
+
+void ClockDisplayHAL::composite()
+{
+    uint8_t *strip = pixels.getPixels();
+    for (uint8_t i = 0; i < NUM_LEDS; ++i, strip += 3)
+    {
+        uint8_t r = 0, g = 0, b = 0;
+        for (uint8_t l = 0; l < LAYER_COUNT; ++l)
+        {
+            if (!layerMasks[l].test(i))
+            {
+                continue;
+            }
+            const uint8_t *src = layers[l] + i * 3;
+            r = blend8(r, src[0], layerAlpha[l]);
+            g = blend8(g, src[1], layerAlpha[l]);
+            b = blend8(b, src[2], layerAlpha[l]);
+        }
+        strip[OFFSET_R] = r;
+        strip[OFFSET_G] = g;
+        strip[OFFSET_B] = b;
+    }
+    dirty = true;
+}
+
 void ClockDisplayHAL::show()
 {
-    pixels.show();
+    // Each push costs a whole WS2812 transfer, so skip identical frames
+    if (!outputStale && (!dirty || memcmp(latched, pixels.getPixels(), sizeof(latched)) == 0))
+    {
+        dirty = false;
+        framesSkipped++;
+        return;
+    }
+
+    memcpy(latched, pixels.getPixels(), sizeof(latched));
+    dirty = false;
+    outputStale = false;
+    uint32_t start = profileTicks();
+    push();
+    lastShowNs = profileTicksToNs(profileTicks() - start);
+    framesSent++;
+}
+
+void ClockDisplayHAL::showStill()
+{
+    if (!dithering)
+    {
+        show();
+        return;
+    }
+    // The frame may equal the last push and still differ from its rounding
+    dithering = false;
+    outputStale = true;
+    show();
+    dithering = true;
+}
+
+void ClockDisplayHAL::setBrightness(uint8_t newBrightness)
+{
+    if (newBrightness == brightness)
+    {
+        return;
+    }
+    brightness = newBrightness;
+    buildOutputLut();
+    outputStale = true;
+}
+
+uint8_t ClockDisplayHAL::getBrightness() const
+{
+    return brightness;
+}
+
+void ClockDisplayHAL::setDithering(bool enabled)
+{
+    dithering = enabled;
+    memset(residual, 0, sizeof(residual));
+}
+
+uint32_t ClockDisplayHAL::getEstimatedCurrentMa() const
+{
+    return (NUM_LEDS * IDLE_UA_PER_LED) / 1000 + (outputSum * CHANNEL_MA + 127) / 255;
+}
+
+uint32_t ClockDisplayHAL::getEstimatedPowerMw() const
+{
+    return getEstimatedCurrentMa() * SUPPLY_MV / 1000;
+}
+
+void ClockDisplayHAL::buildOutputLut()
+{
+    for (uint16_t i = 0; i < 256; ++i)
+    {
+        // 0..65535 is 0..255.996 in 8.8
+        outputLut[i] = ((uint32_t)GAMMA16.values[i] * (brightness + 1)) >> 8;
+    }
+}
+
+void ClockDisplayHAL::correct()
+{
+    outputSum = 0;
+    for (uint16_t i = 0; i < sizeof(latched); ++i)
+    {
+        uint32_t value = outputLut[latched[i]];
+        if (dithering)
+        {
+            value += residual[i];
+            residual[i] = value & 0xFF;
+        }
+        else
+        {
+            // Rounded, a dim channel would vanish and shift the hue, e.g. brown (165, 42, 42)
+            // to pure red at low brightness; anything lit keeps at least one step
+            value = latched[i] != 0 && value < 0x100 ? 0x100 : value + 0x80;
+        }
+        value >>= 8;
+        output[i] = value > 255 ? 255 : value;
+        outputSum += output[i];
+    }
+}
+
+void ClockDisplayHAL::push()
+{
+    correct();
+    if (backend == LedBackend::RMT)
+    {
+        // Encodes out of the output buffer, which is free to change as soon as this returns
+        rmtOutput.write(output);
+    }
+    else if (backend == LedBackend::NEOPIXEL)
+    {
+        // Adafruit sends its own buffer, so swap the corrected frame in just for the transfer
+        uint8_t *strip = pixels.getPixels();
+        memcpy(strip, output, sizeof(output));
+        pixels.show();
+        memcpy(strip, latched, sizeof(latched));
+    }
+}
+
+bool ClockDisplayHAL::isShowComplete()
+{
+    return backend != LedBackend::RMT || rmtOutput.isComplete();
+}
+
+void ClockDisplayHAL::waitForShow()
+{
+    if (backend == LedBackend::RMT)
+    {
+        rmtOutput.waitForCompletion();
+    }
+}
+
+LedBackend ClockDisplayHAL::getBackend() const
+{
+    return backend;
+}
+
+const uint8_t *ClockDisplayHAL::getOutput() const
+{
+    return output;
+}
+
+void ClockDisplayHAL::markDirty()
+{
+    dirty = true;
+}
+
+uint32_t ClockDisplayHAL::getFramesSent() const
+{
+    return framesSent;
+}
+
+uint32_t ClockDisplayHAL::getFramesSkipped() const
+{
+    return framesSkipped;
+}
+
+uint32_t ClockDisplayHAL::getLastShowNs() const
+{
+    return lastShowNs;
+}
+
+void ClockDisplayHAL::resetFrameCounters()
+{
+    framesSent = 0;
+    framesSkipped = 0;
 }
@@ -2,33 +2,133 @@
 #define CLOCKDISPLAYHAL_H
 
 #include <Adafruit_NeoPixel.h>
+#include "RmtLedOutput.h"
+#include "WordLayout.h"
 
+// How frames reach the strip. NEOPIXEL blocks in show() for the whole
+// transfer; RMT sends from a second buffer while the next frame is drawn.
+// EXTERNAL only prepares the corrected frame; the host sends getOutput()
+// itself, as the Raspberry Pi library does.
+enum class LedBackend
+{
+    NEOPIXEL,
+    RMT,
+    EXTERNAL
+};
+
+// Compositing layers, bottom to top. Only the words use one so far; a layer
+// costs NUM_LEDS * 3 bytes, so add one when something draws into it.
+enum class Layer : uint8_t
+{
+    TEXT,
+    COUNT
+};
+
+// Coordinates outside the 12x11 grid are dropped. Build with
+// -DHAL_BOUNDS_ASSERT to assert on them instead while hunting drawing bugs.
 class ClockDisplayHAL
 {
 public:
-    static const uint16_t WIDTH = 12;
-    static const uint16_t HEIGHT = 11;
-    static const uint16_t NUM_LEDS = WIDTH * HEIGHT;
+    static const uint16_t WIDTH = GRID_WIDTH;
+    static const uint16_t HEIGHT = GRID_HEIGHT;
+    static const uint16_t NUM_LEDS = LED_COUNT;
 
-    ClockDisplayHAL(uint8_t pin, uint8_t brightness);
+    ClockDisplayHAL(uint8_t pin, uint8_t brightness, LedBackend backend = LedBackend::NEOPIXEL);
     Adafruit_NeoPixel pixels;
     void setup();
-    void displayWord(const String &word, uint32_t color);
+    void displayWord(WordId word, uint32_t color);
+    void displayMask(const LedMask &mask, uint32_t color);
+    // Paints each word of a phrase in its own color; later words win on shared LEDs
+    void displayPhrase(const WordId *words, uint8_t count, const uint32_t *colors);
+    void displayPhrase(const WordId *words, uint8_t count, uint32_t color);
     void setPixel(uint8_t x, uint8_t y, uint32_t color);
+    // Copy packed RGB888 pixels straight into the strip buffer, row-major from the top left
+    void blitRow(uint8_t y, const uint8_t *rgb, uint8_t x = 0, uint8_t count = WIDTH);
+    void blitFrame(const uint8_t *rgb);
     void clearPixels(bool show = true);
+
+    // Layers hold RGB888 in strip order and only cover the LEDs in their mask.
+    // composite() blends them bottom to top, each at its own alpha, into the
+    // strip buffer; follow it with show(). Animations that own the whole
+    // display (GIFs, effects) draw straight into the strip buffer instead.
+    uint8_t *layerPixels(Layer layer);
+    LedMask &layerMask(Layer layer);
+    void setLayerAlpha(Layer layer, uint8_t alpha);
+    void clearLayer(Layer layer);
+    void composite();
+
+    // Pushes the buffer to the strip only if it differs from the last pushed frame
+    // (or the brightness changed since). Gamma, brightness and dithering are
+    // applied to the copy that goes out, never to the buffer effects draw in.
     void show();
+    // show() with rounding instead of dithering, for a frame that stays on screen:
+    // dithering only evens out over frames that keep coming, and a static one would
+    // keep whichever floor or ceiling its last push got
+    void showStill();
+
+    // Global brightness, folded into the gamma table: one lookup per channel at push time
+    void setBrightness(uint8_t brightness);
+    uint8_t getBrightness() const;
+    // Temporal dithering carries the fraction each channel loses to 8-bit output
+    // into the next frame, so slow fades at low brightness don't step
+    void setDithering(bool enabled);
+    // Supply draw of the last pushed frame, from WS2812 datasheet figures
+    uint32_t getEstimatedCurrentMa() const;
+    uint32_t getEstimatedPowerMw() const;
+    // Call after writing to pixels directly, bypassing the methods above
+    void markDirty();
+    // Fence for the last pushed frame; always complete on the NeoPixel backend
+    bool isShowComplete();
+    void waitForShow();
+    LedBackend getBackend() const;
+    // Last pushed frame after gamma, brightness and dithering, in strip (GRB) order
+    const uint8_t *getOutput() const;
+
+    uint32_t getFramesSent() const;
+    uint32_t getFramesSkipped() const;
+    // Time show() spent pushing the most recent frame; with RMT this excludes the transfer
+    uint32_t getLastShowNs() const;
+    void resetFrameCounters();
 
 private:
     uint8_t brightness;
+    LedBackend backend;
+    RmtLedOutput rmtOutput;
+
+    static const uint8_t LAYER_COUNT = static_cast<uint8_t>(Layer::COUNT);
+    uint8_t layers[LAYER_COUNT][NUM_LEDS * 3];
+    LedMask layerMasks[LAYER_COUNT];
+    uint8_t layerAlpha[LAYER_COUNT];
+
+    // Copy of the last frame pushed to the strip, in NeoPixel byte order
+    uint8_t latched[NUM_LEDS * 3];
+    // Gamma and brightness in 8.8 fixed point, the corrected frame and its dither remainders
+    uint16_t outputLut[256];
+    uint8_t output[NUM_LEDS * 3];
+    uint8_t residual[NUM_LEDS * 3];
+    bool dithering;
+    bool outputStale;
+    // Sum of every channel of the last pushed frame, for the power estimate
+    uint32_t outputSum;
+    bool dirty;
+    uint32_t framesSent;
+    uint32_t framesSkipped;
+    uint32_t lastShowNs;
+
+    // Byte offsets within a pixel of the strip buffer, matching NEO_GRB
+    static const uint8_t OFFSET_R = 1;
+    static const uint8_t OFFSET_G = 0;
+    static const uint8_t OFFSET_B = 2;
 
-    static const struct WordMapping
-    {
-        const char *word;
-        uint8_t start;
-        uint8_t end;
-    } WORDS_TO_LEDS[];
+    // About 20 mA per channel at full duty plus ~1 mA quiescent per LED, at 5 V
+    static const uint32_t CHANNEL_MA = 20;
+    static const uint32_t IDLE_UA_PER_LED = 1000;
+    static const uint32_t SUPPLY_MV = 5000;
 
-    uint16_t cartesianToWordClockLEDStripIndex(uint8_t x, uint8_t y);
+    static bool inBounds(uint8_t x, uint8_t y);
+    void buildOutputLut();
+    void correct();
+    void push();
 };
 
 #endif
@@ -1,6 +1,38 @@
 #include "DisplayEffects.h"
 
-DisplayEffects::DisplayEffects(ClockDisplayHAL *hal) : hal(hal) {}
+// Distance of every cell from the display centre (6, 5.5) in Q8.8, worked out
+// in half-cell units so the centre falls on integers
+struct CentreDistanceTable
+{
+    q8_8 values[ClockDisplayHAL::HEIGHT][ClockDisplayHAL::WIDTH];
+};
+
+constexpr CentreDistanceTable buildCentreDistanceTable()
+{
+    CentreDistanceTable table{};
+    for (int y = 0; y < ClockDisplayHAL::HEIGHT; ++y)
+    {
+        for (int x = 0; x < ClockDisplayHAL::WIDTH; ++x)
+        {
+            int dx = 2 * x - ClockDisplayHAL::WIDTH;
+            int dy = 2 * y - ClockDisplayHAL::HEIGHT;
+            // sqrt(dx^2 + dy^2) / 2 * 256 == sqrt((dx^2 + dy^2) << 14)
+            table.values[y][x] = isqrt((uint32_t)(dx * dx + dy * dy) << 14);
+        }
+    }
+    return table;
+}
+
+static constexpr CentreDistanceTable CENTRE_DISTANCE = buildCentreDistanceTable();
+static_assert(CENTRE_DISTANCE.values[0][0] == 2083, "corner is 8.14 cells from the centre");
+
+const q8_8 RIPPLE_STEP = 77;     // 0.3 cells per frame
+const q8_8 RIPPLE_SPACING = 1024; // rings every 4 cells; a power of two so & replaces fmod
+const q8_8 RIPPLE_WIDTH = 384;    // 1.5 cells
+const uint16_t PULSE_STEP = 834;  // 0.08 rad per frame
+
+DisplayEffects::DisplayEffects(ClockDisplayHAL *hal)
+    : hal(hal), effect(EffectType::RAINBOW_WAVE), effectColor(0), startTime(0), durationMs(0), nextFrameTime(0), running(false), state{} {}
 
 // Color wheel - input 0-255, outputs rainbow colors
 uint32_t DisplayEffects::wheel(uint8_t pos)
@@ -21,9 +53,9 @@ uint32_t DisplayEffects::wheel(uint8_t pos)
 
 uint32_t DisplayEffects::dimColor(uint32_t color, uint8_t brightness)
 {
-    uint8_t r = ((color >> 16) & 0xFF) * brightness / 255;
-    uint8_t g = ((color >> 8) & 0xFF) * brightness / 255;
-    uint8_t b = (color & 0xFF) * brightness / 255;
+    uint8_t r = scale8(color >> 16, brightness);
+    uint8_t g = scale8(color >> 8, brightness);
+    uint8_t b = scale8(color, brightness);
     return hal->pixels.Color(r, g, b);
 }
 
@@ -43,382 +75,400 @@ void DisplayEffects::setAllPixels(uint32_t color)
     }
 }
 
-float DisplayEffects::distance(float x1, float y1, float x2, float y2)
+void DisplayEffects::begin(EffectType newEffect, unsigned long newDurationMs, uint32_t newColor)
+{
+    if (newEffect == EffectType::RANDOM)
+    {
+        beginRandom(newDurationMs);
+        return;
+    }
+
+    effect = newEffect;
+    effectColor = newColor;
+    durationMs = newDurationMs;
+    startTime = millis();
+    nextFrameTime = startTime;
+    running = true;
+    memset(&state, 0, sizeof(state));
+
+    switch (effect)
+    {
+    case EffectType::MATRIX_RAIN:
+        for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
+        {
+            state.matrix.drops[x] = random(-5, ClockDisplayHAL::HEIGHT);
+            state.matrix.speeds[x] = random(1, 4);
+        }
+        break;
+    case EffectType::COLOR_WIPE:
+        state.wipe.wipingOn = true;
+        break;
+    case EffectType::PULSE:
+        state.pulse.color = (effectColor == 0) ? randomColor() : effectColor;
+        break;
+    default:
+        break;
+    }
+}
+
+void DisplayEffects::beginRandom(unsigned long durationMs)
+{
+    // Pick a random effect (excluding RANDOM itself)
+    EffectType effects[] = {
+        EffectType::RAINBOW_WAVE,
+        EffectType::SPARKLE,
+        EffectType::MATRIX_RAIN,
+        EffectType::RIPPLE,
+        EffectType::COLOR_WIPE,
+        EffectType::PULSE,
+        EffectType::CONFETTI,
+        EffectType::FIREWORK};
+    int numEffects = sizeof(effects) / sizeof(effects[0]);
+    EffectType chosen = effects[random(numEffects)];
+    begin(chosen, durationMs);
+}
+
+const char *DisplayEffects::name(EffectType effect)
 {
-    return sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
+    switch (effect)
+    {
+    case EffectType::RAINBOW_WAVE:
+        return "RAINBOW_WAVE";
+    case EffectType::SPARKLE:
+        return "SPARKLE";
+    case EffectType::MATRIX_RAIN:
+        return "MATRIX_RAIN";
+    case EffectType::RIPPLE:
+        return "RIPPLE";
+    case EffectType::COLOR_WIPE:
+        return "COLOR_WIPE";
+    case EffectType::PULSE:
+        return "PULSE";
+    case EffectType::CONFETTI:
+        return "CONFETTI";
+    case EffectType::FIREWORK:
+        return "FIREWORK";
+    case EffectType::RANDOM:
+        return "RANDOM";
+    }
+    return "";
 }
 
-void DisplayEffects::playEffect(EffectType effect, unsigned long durationMs)
+void DisplayEffects::tick(unsigned long now)
 {
+    if (!running)
+    {
+        return;
+    }
+    if (now - startTime >= durationMs)
+    {
+        running = false;
+        return;
+    }
+    if ((long)(now - nextFrameTime) < 0)
+    {
+        return;
+    }
+
+    unsigned long frameDelay = 0;
     switch (effect)
     {
     case EffectType::RAINBOW_WAVE:
-        rainbowWave(durationMs);
+        frameDelay = rainbowWaveFrame();
         break;
     case EffectType::SPARKLE:
-        sparkle(durationMs);
+        frameDelay = sparkleFrame();
         break;
     case EffectType::MATRIX_RAIN:
-        matrixRain(durationMs);
+        frameDelay = matrixRainFrame();
         break;
     case EffectType::RIPPLE:
-        ripple(durationMs);
+        frameDelay = rippleFrame();
         break;
     case EffectType::COLOR_WIPE:
-        colorWipe(durationMs);
+        frameDelay = colorWipeFrame();
         break;
     case EffectType::PULSE:
-        pulse(durationMs);
+        frameDelay = pulseFrame();
         break;
     case EffectType::CONFETTI:
-        confetti(durationMs);
+        frameDelay = confettiFrame();
         break;
     case EffectType::FIREWORK:
-        firework(durationMs);
+        frameDelay = fireworkFrame();
         break;
     case EffectType::RANDOM:
-        playRandomEffect(durationMs);
         break;
     }
+    // Advance from the previous deadline so the frame rate doesn't drift with the
+    // scheduler's tick granularity; resync if we fell more than a frame behind
+    nextFrameTime += frameDelay;
+    if ((long)(now - nextFrameTime) > 0)
+    {
+        nextFrameTime = now + frameDelay;
+    }
 }
 
-void DisplayEffects::playRandomEffect(unsigned long durationMs)
+bool DisplayEffects::done() const
 {
-    // Pick a random effect (excluding RANDOM itself)
-    EffectType effects[] = {
-        EffectType::RAINBOW_WAVE,
-        EffectType::SPARKLE,
-        EffectType::MATRIX_RAIN,
-        EffectType::RIPPLE,
-        EffectType::COLOR_WIPE,
-        EffectType::PULSE,
-        EffectType::CONFETTI,
-        EffectType::FIREWORK};
-    int numEffects = sizeof(effects) / sizeof(effects[0]);
-    EffectType chosen = effects[random(numEffects)];
-    playEffect(chosen, durationMs);
+    return !running;
 }
 
-// Rainbow wave sweeping across the display
-void DisplayEffects::rainbowWave(unsigned long durationMs)
+unsigned long DisplayEffects::nextDeadline() const
 {
-    unsigned long startTime = millis();
-    uint8_t offset = 0;
+    return nextFrameTime;
+}
 
-    while (millis() - startTime < durationMs)
+// Rainbow wave sweeping across the display
+unsigned long DisplayEffects::rainbowWaveFrame()
+{
+    for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
     {
-        for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
+        for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
         {
-            for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
-            {
-                // Create diagonal rainbow wave
-                uint8_t colorIndex = (x * 10 + y * 20 + offset) & 0xFF;
-                hal->setPixel(x, y, wheel(colorIndex));
-            }
+            // Create diagonal rainbow wave
+            uint8_t colorIndex = (x * 10 + y * 20 + state.rainbow.offset) & 0xFF;
+            hal->setPixel(x, y, wheel(colorIndex));
         }
-        hal->show();
-        offset += 5;
-        delay(30);
     }
+    hal->show();
+    state.rainbow.offset += 5;
+    return 30;
 }
 
 // Sparkle/twinkle effect - random pixels flash
-void DisplayEffects::sparkle(unsigned long durationMs, uint32_t baseColor)
+unsigned long DisplayEffects::sparkleFrame()
 {
-    unsigned long startTime = millis();
+    uint32_t baseColor = (effectColor == 0) ? 0xFFFFFF : effectColor;
+    hal->clearPixels(false);
 
-    while (millis() - startTime < durationMs)
+    // Light up random pixels
+    int numSparkles = random(5, 15);
+    for (int i = 0; i < numSparkles; i++)
     {
-        hal->clearPixels(false);
-
-        // Light up random pixels
-        int numSparkles = random(5, 15);
-        for (int i = 0; i < numSparkles; i++)
-        {
-            uint8_t x = random(ClockDisplayHAL::WIDTH);
-            uint8_t y = random(ClockDisplayHAL::HEIGHT);
-            uint8_t brightness = random(100, 255);
-            hal->setPixel(x, y, dimColor(baseColor, brightness));
-        }
-        hal->show();
-        delay(50);
+        uint8_t x = random(ClockDisplayHAL::WIDTH);
+        uint8_t y = random(ClockDisplayHAL::HEIGHT);
+        uint8_t brightness = random(100, 255);
+        hal->setPixel(x, y, dimColor(baseColor, brightness));
     }
+    hal->show();
+    return 50;
 }
 
 // Matrix rain effect - falling green columns
-void DisplayEffects::matrixRain(unsigned long durationMs)
+unsigned long DisplayEffects::matrixRainFrame()
 {
-    unsigned long startTime = millis();
+    int8_t *drops = state.matrix.drops;
+    uint8_t *speeds = state.matrix.speeds;
 
-    // Track drop positions for each column
-    int8_t drops[ClockDisplayHAL::WIDTH];
-    uint8_t speeds[ClockDisplayHAL::WIDTH];
+    hal->clearPixels(false);
 
-    // Initialize drops
     for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
     {
-        drops[x] = random(-5, ClockDisplayHAL::HEIGHT);
-        speeds[x] = random(1, 4);
-    }
-
-    uint8_t frameCount = 0;
-
-    while (millis() - startTime < durationMs)
-    {
-        hal->clearPixels(false);
-
-        for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
+        // Draw the trail
+        for (int8_t trail = 0; trail < 5; trail++)
         {
-            // Draw the trail
-            for (int8_t trail = 0; trail < 5; trail++)
+            int8_t y = drops[x] - trail;
+            if (y >= 0 && y < ClockDisplayHAL::HEIGHT)
             {
-                int8_t y = drops[x] - trail;
-                if (y >= 0 && y < ClockDisplayHAL::HEIGHT)
-                {
-                    uint8_t brightness = 255 - (trail * 50);
-                    uint32_t color = hal->pixels.Color(0, brightness, 0);
-                    hal->setPixel(x, y, color);
-                }
+                uint8_t brightness = 255 - (trail * 50);
+                uint32_t color = hal->pixels.Color(0, brightness, 0);
+                hal->setPixel(x, y, color);
             }
+        }
 
-            // Move drop down based on speed
-            if (frameCount % speeds[x] == 0)
+        // Move drop down based on speed
+        if (state.matrix.frameCount % speeds[x] == 0)
+        {
+            drops[x]++;
+            if (drops[x] > ClockDisplayHAL::HEIGHT + 5)
             {
-                drops[x]++;
-                if (drops[x] > ClockDisplayHAL::HEIGHT + 5)
-                {
-                    drops[x] = random(-5, 0);
-                    speeds[x] = random(1, 4);
-                }
+                drops[x] = random(-5, 0);
+                speeds[x] = random(1, 4);
             }
         }
-
-        hal->show();
-        frameCount++;
-        delay(40);
     }
+
+    hal->show();
+    state.matrix.frameCount++;
+    return 40;
 }
 
 // Ripple effect - expanding circles from center
-void DisplayEffects::ripple(unsigned long durationMs)
+unsigned long DisplayEffects::rippleFrame()
 {
-    unsigned long startTime = millis();
-    float centerX = ClockDisplayHAL::WIDTH / 2.0;
-    float centerY = ClockDisplayHAL::HEIGHT / 2.0;
-    float maxDist = distance(0, 0, centerX, centerY);
-    float radius = 0;
-    uint8_t colorOffset = 0;
-
-    while (millis() - startTime < durationMs)
-    {
-        hal->clearPixels(false);
+    const q8_8 maxDist = CENTRE_DISTANCE.values[0][0];
 
-        for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
+    hal->clearPixels(false);
+
+    for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
+    {
+        for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
         {
-            for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
+            q8_8 dist = CENTRE_DISTANCE.values[y][x];
+
+            // Create multiple ripple rings; the mask keeps the phase positive
+            uint16_t ripplePhase = (dist - state.ripple.radius) & (RIPPLE_SPACING - 1);
+
+            if (ripplePhase < RIPPLE_WIDTH)
             {
-                float dist = distance(x, y, centerX, centerY);
-
-                // Create multiple ripple rings
-                float ripplePhase = fmod(dist - radius, 4.0);
-                if (ripplePhase < 0)
-                    ripplePhase += 4.0;
-
-                if (ripplePhase < 1.5)
-                {
-                    uint8_t brightness = 255 * (1.0 - ripplePhase / 1.5);
-                    uint32_t color = dimColor(wheel(colorOffset + (uint8_t)(dist * 20)), brightness);
-                    hal->setPixel(x, y, color);
-                }
+                // 255 * (1 - phase / 1.5), with 255 / 384 ~= 170 / 256
+                uint8_t brightness = 255 - ((ripplePhase * 170) >> 8);
+                uint32_t color = dimColor(wheel(state.ripple.colorOffset + ((dist * 20) >> 8)), brightness);
+                hal->setPixel(x, y, color);
             }
         }
+    }
 
-        hal->show();
-        radius += 0.3;
-        if (radius > maxDist + 4)
-        {
-            radius = 0;
-            colorOffset += 30;
-        }
-        delay(30);
+    hal->show();
+    state.ripple.radius += RIPPLE_STEP;
+    if (state.ripple.radius > maxDist + toQ8_8(4))
+    {
+        state.ripple.radius = 0;
+        state.ripple.colorOffset += 30;
     }
+    return 30;
 }
 
-// Color wipe - fill display with color, then clear
-void DisplayEffects::colorWipe(unsigned long durationMs, uint32_t color)
+// Color wipe - fill display with color diagonally, pause, then clear the same way
+unsigned long DisplayEffects::colorWipeFrame()
 {
-    unsigned long startTime = millis();
-    unsigned long elapsed;
+    const uint8_t diagonals = ClockDisplayHAL::WIDTH + ClockDisplayHAL::HEIGHT;
 
-    while ((elapsed = millis() - startTime) < durationMs)
+    // Pick new color for each cycle if not specified
+    if (state.wipe.wipingOn && state.wipe.diag == 0)
     {
-        // Pick new color for each cycle if not specified
-        uint32_t wipeColor = (color == 0) ? randomColor() : color;
-
-        // Wipe on (diagonal)
-        for (int diag = 0; diag < ClockDisplayHAL::WIDTH + ClockDisplayHAL::HEIGHT; diag++)
-        {
-            for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
-            {
-                uint8_t y = diag - x;
-                if (y < ClockDisplayHAL::HEIGHT)
-                {
-                    hal->setPixel(x, y, wipeColor);
-                }
-            }
-            hal->show();
-            delay(20);
-
-            if (millis() - startTime >= durationMs)
-                return;
-        }
-
-        delay(200);
+        state.wipe.color = (effectColor == 0) ? randomColor() : effectColor;
+    }
 
-        // Wipe off (opposite diagonal)
-        for (int diag = 0; diag < ClockDisplayHAL::WIDTH + ClockDisplayHAL::HEIGHT; diag++)
+    uint32_t pixelColor = state.wipe.wipingOn ? state.wipe.color : 0;
+    for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
+    {
+        uint8_t y = state.wipe.diag - x;
+        if (y < ClockDisplayHAL::HEIGHT)
         {
-            for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
-            {
-                uint8_t y = diag - x;
-                if (y < ClockDisplayHAL::HEIGHT)
-                {
-                    hal->setPixel(x, y, 0);
-                }
-            }
-            hal->show();
-            delay(20);
-
-            if (millis() - startTime >= durationMs)
-                return;
+            hal->setPixel(x, y, pixelColor);
         }
+    }
+    hal->show();
 
-        delay(100);
+    if (++state.wipe.diag < diagonals)
+    {
+        return 20;
     }
+
+    // Hold the full display longer than the empty one
+    state.wipe.diag = 0;
+    state.wipe.wipingOn = !state.wipe.wipingOn;
+    return state.wipe.wipingOn ? 20 + 100 : 20 + 200;
 }
 
 // Pulse/breathe effect - all LEDs fade in and out
-void DisplayEffects::pulse(unsigned long durationMs, uint32_t color)
+unsigned long DisplayEffects::pulseFrame()
 {
-    unsigned long startTime = millis();
-    uint32_t pulseColor = (color == 0) ? randomColor() : color;
-    float phase = 0;
-
-    while (millis() - startTime < durationMs)
+    // Sine wave for smooth breathing
+    uint8_t brightness = sin8(state.pulse.phase >> 8);
+    setAllPixels(dimColor(state.pulse.color, brightness));
+    hal->show();
+
+    uint16_t previousPhase = state.pulse.phase;
+    state.pulse.phase += PULSE_STEP;
+    if (state.pulse.phase < previousPhase)
     {
-        // Sine wave for smooth breathing
-        uint8_t brightness = (uint8_t)(127.5 * (1.0 + sin(phase)));
-        setAllPixels(dimColor(pulseColor, brightness));
-        hal->show();
-
-        phase += 0.08;
-        if (phase > TWO_PI)
-        {
-            phase -= TWO_PI;
-            pulseColor = randomColor(); // Change color each cycle
-        }
-        delay(20);
+        state.pulse.color = (effectColor == 0) ? randomColor() : effectColor; // Change color each cycle
     }
+    return 20;
 }
 
 // Confetti - random colored pixels appearing and fading
-void DisplayEffects::confetti(unsigned long durationMs)
+unsigned long DisplayEffects::confettiFrame()
 {
-    unsigned long startTime = millis();
-
-    // Pixel brightness array for fading
-    uint8_t brightness[ClockDisplayHAL::WIDTH][ClockDisplayHAL::HEIGHT] = {0};
-    uint32_t colors[ClockDisplayHAL::WIDTH][ClockDisplayHAL::HEIGHT] = {0};
+    auto &brightness = state.confetti.brightness;
+    auto &colors = state.confetti.colors;
 
-    while (millis() - startTime < durationMs)
+    // Add new confetti
+    for (int i = 0; i < 2; i++)
     {
-        // Add new confetti
-        for (int i = 0; i < 2; i++)
-        {
-            uint8_t x = random(ClockDisplayHAL::WIDTH);
-            uint8_t y = random(ClockDisplayHAL::HEIGHT);
-            brightness[x][y] = 255;
-            colors[x][y] = randomColor();
-        }
+        uint8_t x = random(ClockDisplayHAL::WIDTH);
+        uint8_t y = random(ClockDisplayHAL::HEIGHT);
+        brightness[x][y] = 255;
+        colors[x][y] = randomColor();
+    }
 
-        // Update display and fade
-        for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
+    // Update display and fade
+    for (uint8_t y = 0; y < ClockDisplayHAL::HEIGHT; y++)
+    {
+        for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
         {
-            for (uint8_t x = 0; x < ClockDisplayHAL::WIDTH; x++)
+            if (brightness[x][y] > 0)
             {
-                if (brightness[x][y] > 0)
-                {
-                    hal->setPixel(x, y, dimColor(colors[x][y], brightness[x][y]));
-                    brightness[x][y] = (brightness[x][y] > 15) ? brightness[x][y] - 15 : 0;
-                }
-                else
-                {
-                    hal->setPixel(x, y, 0);
-                }
+                hal->setPixel(x, y, dimColor(colors[x][y], brightness[x][y]));
+                brightness[x][y] = (brightness[x][y] > 15) ? brightness[x][y] - 15 : 0;
+            }
+            else
+            {
+                hal->setPixel(x, y, 0);
             }
         }
-
-        hal->show();
-        delay(30);
     }
+
+    hal->show();
+    return 30;
 }
 
 // Firework effect - bursts from random points
-void DisplayEffects::firework(unsigned long durationMs)
+unsigned long DisplayEffects::fireworkFrame()
 {
-    unsigned long startTime = millis();
+    const uint8_t burstFrames = 20;
+    q8_8 *px = state.firework.px, *py = state.firework.py;
+    q8_8 *vx = state.firework.vx, *vy = state.firework.vy;
 
-    while (millis() - startTime < durationMs)
+    if (state.firework.frame == 0)
     {
         // Launch point
         uint8_t burstX = random(2, ClockDisplayHAL::WIDTH - 2);
         uint8_t burstY = random(2, ClockDisplayHAL::HEIGHT - 2);
-        uint32_t burstColor = randomColor();
-
-        // Particle positions and velocities
-        const int numParticles = 12;
-        float px[numParticles], py[numParticles];
-        float vx[numParticles], vy[numParticles];
+        state.firework.color = randomColor();
 
-        // Initialize particles radiating outward
-        for (int i = 0; i < numParticles; i++)
+        // Initialize particles radiating outward at half a cell per frame;
+        // the sine table's 127 peak is 0.5 in Q8.8
+        for (int i = 0; i < FIREWORK_PARTICLES; i++)
         {
-            float angle = (TWO_PI / numParticles) * i;
-            px[i] = burstX;
-            py[i] = burstY;
-            vx[i] = cos(angle) * 0.5;
-            vy[i] = sin(angle) * 0.5;
+            uint8_t angle = i * 256 / FIREWORK_PARTICLES;
+            px[i] = toQ8_8(burstX);
+            py[i] = toQ8_8(burstY);
+            vx[i] = icos8(angle);
+            vy[i] = isin8(angle);
         }
+    }
 
-        // Animate burst
-        for (int frame = 0; frame < 20; frame++)
-        {
-            hal->clearPixels(false);
-
-            uint8_t brightness = 255 - (frame * 12);
-
-            for (int i = 0; i < numParticles; i++)
-            {
-                px[i] += vx[i];
-                py[i] += vy[i];
+    hal->clearPixels(false);
 
-                int x = (int)px[i];
-                int y = (int)py[i];
+    uint8_t brightness = 255 - (state.firework.frame * 12);
 
-                if (x >= 0 && x < ClockDisplayHAL::WIDTH &&
-                    y >= 0 && y < ClockDisplayHAL::HEIGHT)
-                {
-                    hal->setPixel(x, y, dimColor(burstColor, brightness));
-                }
-            }
+    for (int i = 0; i < FIREWORK_PARTICLES; i++)
+    {
+        px[i] += vx[i];
+        py[i] += vy[i];
 
-            hal->show();
-            delay(40);
+        int x = fromQ8_8(px[i]);
+        int y = fromQ8_8(py[i]);
 
-            if (millis() - startTime >= durationMs)
-                return;
+        if (x >= 0 && x < ClockDisplayHAL::WIDTH &&
+            y >= 0 && y < ClockDisplayHAL::HEIGHT)
+        {
+            hal->setPixel(x, y, dimColor(state.firework.color, brightness));
         }
+    }
+
+    hal->show();
 
-        delay(100);
+    if (++state.firework.frame < burstFrames)
+    {
+        return 40;
     }
+
+    // Pause before the next burst
+    state.firework.frame = 0;
+    return 40 + 100;
 }
@@ -2,7 +2,9 @@
 #define DISPLAY_EFFECTS_H
 
 #include <Arduino.h>
+#include "Animation.h"
 #include "ClockDisplayHAL.h"
+#include "FixedMath.h"
 
 enum class EffectType {
     RAINBOW_WAVE,
@@ -16,36 +18,92 @@ enum class EffectType {
     RANDOM
 };
 
-class DisplayEffects
+class DisplayEffects : public Animation
 {
 public:
     DisplayEffects(ClockDisplayHAL *hal);
 
-    // Play a specific effect for a duration
-    void playEffect(EffectType effect, unsigned long durationMs);
+    // Start an effect for a duration; color is used by SPARKLE, COLOR_WIPE and PULSE (0 = default)
+    void begin(EffectType effect, unsigned long durationMs, uint32_t color = 0);
 
-    // Play a random effect
-    void playRandomEffect(unsigned long durationMs);
+    // Start a random effect
+    void beginRandom(unsigned long durationMs);
 
-    // Individual effects (can be called directly)
-    void rainbowWave(unsigned long durationMs);
-    void sparkle(unsigned long durationMs, uint32_t baseColor = 0xFFFFFF);
-    void matrixRain(unsigned long durationMs);
-    void ripple(unsigned long durationMs);
-    void colorWipe(unsigned long durationMs, uint32_t color = 0);
-    void pulse(unsigned long durationMs, uint32_t color = 0);
-    void confetti(unsigned long durationMs);
-    void firework(unsigned long durationMs);
+    static const char *name(EffectType effect);
+
+    void tick(unsigned long now) override;
+    bool done() const override;
+    unsigned long nextDeadline() const override;
 
 private:
     ClockDisplayHAL *hal;
 
+    EffectType effect;
+    uint32_t effectColor;
+    unsigned long startTime;
+    unsigned long durationMs;
+    unsigned long nextFrameTime;
+    bool running;
+
+    // Per-effect state carried between frames
+    static const int FIREWORK_PARTICLES = 12;
+    union
+    {
+        struct
+        {
+            uint8_t offset;
+        } rainbow;
+        struct
+        {
+            int8_t drops[ClockDisplayHAL::WIDTH];
+            uint8_t speeds[ClockDisplayHAL::WIDTH];
+            uint8_t frameCount;
+        } matrix;
+        struct
+        {
+            q8_8 radius;
+            uint8_t colorOffset;
+        } ripple;
+        struct
+        {
+            uint32_t color;
+            uint8_t diag;
+            bool wipingOn;
+        } wipe;
+        struct
+        {
+            uint32_t color;
+            uint16_t phase; // full turn is 65536
+        } pulse;
+        struct
+        {
+            uint8_t brightness[ClockDisplayHAL::WIDTH][ClockDisplayHAL::HEIGHT];
+            uint32_t colors[ClockDisplayHAL::WIDTH][ClockDisplayHAL::HEIGHT];
+        } confetti;
+        struct
+        {
+            q8_8 px[FIREWORK_PARTICLES], py[FIREWORK_PARTICLES];
+            q8_8 vx[FIREWORK_PARTICLES], vy[FIREWORK_PARTICLES];
+            uint32_t color;
+            uint8_t frame;
+        } firework;
+    } state;
+
+    // Each renders one frame and returns the delay until the next one
+    unsigned long rainbowWaveFrame();
+    unsigned long sparkleFrame();
+    unsigned long matrixRainFrame();
+    unsigned long rippleFrame();
+    unsigned long colorWipeFrame();
+    unsigned long pulseFrame();
+    unsigned long confettiFrame();
+    unsigned long fireworkFrame();
+
     // Helper functions
     uint32_t wheel(uint8_t pos);  // Color wheel for rainbow effects
     uint32_t dimColor(uint32_t color, uint8_t brightness);
     uint32_t randomColor();
     void setAllPixels(uint32_t color);
-    float distance(float x1, float y1, float x2, float y2);
 };
 
 #endif
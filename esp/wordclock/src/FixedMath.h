@@ -0,0 +1,116 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+// Integer replacements for the float maths in the effects. The ESP32-C3 has
+// no FPU, so sin/sqrt/fmod are software routines costing thousands of cycles.
+
+// Q8.8 fixed point: 8 integer bits, 8 fractional bits
+typedef int16_t q8_8;
+constexpr q8_8 Q8_8_ONE = 256;
+
+constexpr q8_8 toQ8_8(int value)
+{
+    return value * Q8_8_ONE;
+}
+
+// Integer part, rounding towards negative infinity
+constexpr int fromQ8_8(q8_8 value)
+{
+    return value >> 8;
+}
+
+// i * scale / 256 with scale8(x, 255) == x, in one multiply and shift
+constexpr uint8_t scale8(uint8_t i, uint8_t scale)
+{
+    return ((uint16_t)i * (1 + scale)) >> 8;
+}
+
+// a at amount 0 to b at amount 255, exact at both ends
+constexpr uint8_t blend8(uint8_t a, uint8_t b, uint8_t amount)
+{
+    uint16_t weight = amount + (amount >> 7); // 0..256
+    return (a * (256 - weight) + b * weight) >> 8;
+}
+
+// Angles are 0-255 for a full turn
+struct SineTable
+{
+    int8_t values[256];
+};
+
+constexpr SineTable buildSineTable()
+{
+    SineTable table{};
+    const double pi = 3.14159265358979323846;
+    for (int i = 0; i < 256; ++i)
+    {
+        // Taylor series around the nearest of 0 and pi, accurate to well under 1/127
+        double x = 2 * pi * i / 256;
+        double sign = 1;
+        if (x > pi)
+        {
+            x -= pi;
+            sign = -1;
+        }
+        if (x > pi / 2)
+        {
+            x = pi - x;
+        }
+        double term = x, sum = x;
+        for (int n = 1; n < 8; ++n)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        double scaled = sign * sum * 127;
+        table.values[i] = (int8_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    }
+    return table;
+}
+
+inline constexpr SineTable SINE_TABLE = buildSineTable();
+
+// -127..127
+constexpr int8_t isin8(uint8_t angle)
+{
+    return SINE_TABLE.values[angle];
+}
+
+constexpr int8_t icos8(uint8_t angle)
+{
+    return SINE_TABLE.values[(uint8_t)(angle + 64)];
+}
+
+// 1..255, centred on 128
+constexpr uint8_t sin8(uint8_t angle)
+{
+    return 128 + isin8(angle);
+}
+
+constexpr uint32_t isqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    for (uint32_t bit = 1UL << 30; bit != 0; bit >>= 2)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+    }
+    return root;
+}
+
+static_assert(isin8(0) == 0 && isin8(64) == 127 && isin8(128) == 0 && isin8(192) == -127, "sine table quadrants");
+static_assert(icos8(0) == 127 && icos8(128) == -127, "cosine is sine shifted a quarter turn");
+static_assert(scale8(255, 255) == 255 && scale8(255, 0) == 0 && scale8(200, 127) == 100, "scale8");
+static_assert(blend8(10, 200, 0) == 10 && blend8(10, 200, 255) == 200 && blend8(200, 10, 255) == 10 && blend8(0, 255, 128) == 128, "blend8");
+static_assert(isqrt(0) == 0 && isqrt(15) == 3 && isqrt(16) == 4 && isqrt(1UL << 30) == 1UL << 15, "isqrt");
+
+#endif
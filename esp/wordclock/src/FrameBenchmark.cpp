@@ -0,0 +1,152 @@
+#include "FrameBenchmark.h"
+#include "ProfileClock.h"
+#include "WordClock.h"
+#include <algorithm>
+#include <stdarg.h>
+
+// Long enough that no animation ends during a run
+#define BENCHMARK_DURATION_MS 0x7FFFFFFFUL
+
+FrameBenchmark::FrameBenchmark(ClockDisplayHAL *clockDisplayHAL, DisplayEffects *displayEffects, GifPlayer *gifPlayer, ClipPlayer *clipPlayer, GifCache *gifCache)
+    : clockDisplayHAL(clockDisplayHAL), displayEffects(displayEffects), gifPlayer(gifPlayer), clipPlayer(clipPlayer), gifCache(gifCache),
+      frames(0), renderNs(nullptr), showNs(nullptr), firstResult(true) {}
+
+void FrameBenchmark::run(uint16_t frameCount)
+{
+    frames = frameCount;
+    renderNs = (uint32_t *)malloc(frames * sizeof(uint32_t));
+    showNs = (uint32_t *)malloc(frames * sizeof(uint32_t));
+    if (renderNs == nullptr || showNs == nullptr || frames == 0)
+    {
+        free(renderNs);
+        free(showNs);
+        Serial.println("{\"error\":\"benchmark buffers\"}");
+        return;
+    }
+
+    // Fill the cache up front so its log lines don't land inside the JSON
+    for (int i = 0; i < NUM_GIFS; ++i)
+    {
+        gifCache->fetch(GIF_URLS[i]);
+    }
+
+    const char *backend = clockDisplayHAL->getBackend() == LedBackend::RMT ? "rmt" : "neopixel";
+#ifdef __LINUX__
+    print("{\"platform\":\"host\",\"cpu_mhz\":0,\"led_backend\":\"%s\",\"frames\":%u,\"results\":[", backend, frames);
+#else
+    print("{\"platform\":\"esp32\",\"cpu_mhz\":%u,\"led_backend\":\"%s\",\"frames\":%u,\"results\":[", profileCpuMHz(), backend, frames);
+#endif
+
+    for (uint8_t effect = 0; effect < static_cast<uint8_t>(EffectType::RANDOM); ++effect)
+    {
+        displayEffects->begin(static_cast<EffectType>(effect), BENCHMARK_DURATION_MS);
+        measure(DisplayEffects::name(static_cast<EffectType>(effect)), "effect", displayEffects, 0);
+    }
+
+    for (int i = 0; i < NUM_GIFS; ++i)
+    {
+        const char *url = GIF_URLS[i];
+        const char *name = strrchr(url, '/') + 1;
+        const char *cachedPath = gifCache->fetch(url);
+        if (cachedPath == nullptr || !gifPlayer->loadFile(cachedPath))
+        {
+            continue;
+        }
+
+        // Live decoding first, then the same GIF as a pre-decoded clip
+        uint32_t start = profileTicks();
+        bool decoded = gifPlayer->decodeToClip(clipPlayer->getClip());
+        uint32_t ingestNs = profileTicksToNs(profileTicks() - start);
+
+        if (gifPlayer->begin(BENCHMARK_DURATION_MS))
+        {
+            measure(name, "gif", gifPlayer, 0);
+        }
+        if (decoded && clipPlayer->begin(BENCHMARK_DURATION_MS))
+        {
+            measure(name, "clip", clipPlayer, ingestNs);
+        }
+    }
+
+    Serial.println("]}");
+    free(renderNs);
+    free(showNs);
+    renderNs = showNs = nullptr;
+    clockDisplayHAL->clearPixels();
+}
+
+void FrameBenchmark::measure(const char *name, const char *kind, Animation *animation, uint32_t ingestNs)
+{
+    unsigned long impliedMs = 0;
+    unsigned long firstFrameMs = 0;
+    uint16_t sent = 0;
+
+    for (uint16_t i = 0; i < frames; ++i)
+    {
+        // Wait for the deadline as FrameScheduler would, so pacing is part of the result
+        unsigned long now = millis();
+        long untilDeadline = (long)(animation->nextDeadline() - now);
+        if (untilDeadline > 0)
+        {
+            delay(untilDeadline);
+            now = millis();
+        }
+        if (i == 0)
+        {
+            firstFrameMs = now;
+        }
+
+        unsigned long deadline = animation->nextDeadline();
+        uint32_t framesSent = clockDisplayHAL->getFramesSent();
+        uint32_t start = profileTicks();
+        animation->tick(now);
+        uint32_t totalNs = profileTicksToNs(profileTicks() - start);
+
+        bool shown = clockDisplayHAL->getFramesSent() != framesSent;
+        showNs[i] = shown ? clockDisplayHAL->getLastShowNs() : 0;
+        renderNs[i] = totalNs > showNs[i] ? totalNs - showNs[i] : 0;
+        impliedMs += animation->nextDeadline() - deadline;
+        sent += shown;
+    }
+    unsigned long elapsedMs = millis() - firstFrameMs;
+
+    print("%s{\"name\":\"%s\",\"kind\":\"%s\",\"frames\":%u,\"shows_sent\":%u,", firstResult ? "" : ",", name, kind, frames, sent);
+    firstResult = false;
+    printSummary("render_ns", renderNs, frames);
+    printSummary("show_ns", showNs, frames);
+    if (strcmp(kind, "gif") == 0)
+    {
+        // The bundled GIFs are 12x11, so a full frame is one GIFDraw call per display row
+        print("\"scanline_ns\":%lu,", (unsigned long)renderNs[frames / 2] / ClockDisplayHAL::HEIGHT);
+    }
+    if (ingestNs != 0)
+    {
+        print("\"decode_to_clip_ns\":%lu,", (unsigned long)ingestNs);
+    }
+    // The last frame's delay is not part of the elapsed time
+    float targetFps = impliedMs ? 1000.0f * frames / impliedMs : 0;
+    float achievedFps = elapsedMs ? 1000.0f * (frames - 1) / elapsedMs : 0;
+    print("\"target_fps\":%.1f,\"achieved_fps\":%.1f}", targetFps, achievedFps);
+}
+
+void FrameBenchmark::printSummary(const char *key, uint32_t *samples, uint16_t count)
+{
+    std::sort(samples, samples + count);
+    uint16_t p99 = (uint32_t)count * 99 / 100;
+    if (p99 >= count)
+    {
+        p99 = count - 1;
+    }
+    print("\"%s\":{\"min\":%lu,\"median\":%lu,\"p99\":%lu},", key,
+          (unsigned long)samples[0], (unsigned long)samples[count / 2], (unsigned long)samples[p99]);
+}
+
+void FrameBenchmark::print(const char *format, ...)
+{
+    char line[192];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    Serial.print(line);
+}
@@ -0,0 +1,39 @@
+#ifndef FRAME_BENCHMARK_H
+#define FRAME_BENCHMARK_H
+
+#include <Arduino.h>
+#include "ClockDisplayHAL.h"
+#include "DisplayEffects.h"
+#include "GifPlayer.h"
+#include "ClipPlayer.h"
+#include "GifCache.h"
+
+// Plays every effect and every hourly GIF for a fixed number of frames in real
+// time and prints one line of JSON to Serial with, per animation, the
+// min/median/p99 time spent rendering a frame and pushing it with show(), and
+// the frame rate achieved against the one its delays ask for. Enabled by
+// defining BENCHMARK_FRAMES in config.h (or -DBENCHMARK_FRAMES=N).
+class FrameBenchmark
+{
+public:
+    FrameBenchmark(ClockDisplayHAL *clockDisplayHAL, DisplayEffects *displayEffects, GifPlayer *gifPlayer, ClipPlayer *clipPlayer, GifCache *gifCache);
+    void run(uint16_t frames);
+
+private:
+    ClockDisplayHAL *clockDisplayHAL;
+    DisplayEffects *displayEffects;
+    GifPlayer *gifPlayer;
+    ClipPlayer *clipPlayer;
+    GifCache *gifCache;
+
+    uint16_t frames;
+    uint32_t *renderNs;
+    uint32_t *showNs;
+    bool firstResult;
+
+    void measure(const char *name, const char *kind, Animation *animation, uint32_t ingestNs);
+    void printSummary(const char *key, uint32_t *samples, uint16_t count);
+    static void print(const char *format, ...);
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "FramePacer.h"
+#include "SerialHelper.h"
+
+FramePacer::FramePacer() : deadline(0), consecutiveDrops(0), stats{} {}
+
+uint16_t FramePacer::normalizeDelay(int delayMs)
+{
+    return delayMs < MIN_DELAY_MS ? DEFAULT_DELAY_MS : delayMs;
+}
+
+void FramePacer::start(unsigned long now)
+{
+    deadline = now;
+    consecutiveDrops = 0;
+    stats = {};
+}
+
+bool FramePacer::due(unsigned long now) const
+{
+    return (long)(now - deadline) >= 0;
+}
+
+unsigned long FramePacer::nextDeadline() const
+{
+    return deadline;
+}
+
+bool FramePacer::late(unsigned long now, uint16_t delayMs) const
+{
+    return consecutiveDrops < MAX_DROPS_PER_FRAME && (long)(now - (deadline + delayMs)) >= 0;
+}
+
+void FramePacer::drop(uint16_t delayMs)
+{
+    deadline += delayMs;
+    consecutiveDrops++;
+    stats.dropped++;
+}
+
+void FramePacer::present(unsigned long now, uint16_t delayMs)
+{
+    unsigned long jitter = now - deadline;
+    stats.shown++;
+    stats.totalJitterMs += jitter;
+    if (jitter > stats.maxJitterMs)
+    {
+        stats.maxJitterMs = jitter;
+    }
+
+    consecutiveDrops = 0;
+    deadline += delayMs;
+    // Only after hitting the drop limit can the next deadline already be behind us
+    if ((long)(now - deadline) >= 0)
+    {
+        deadline = now + delayMs;
+    }
+}
+
+const FramePacingStats &FramePacer::getStats() const
+{
+    return stats;
+}
+
+void FramePacer::logStats(const char *label) const
+{
+    SERIAL_PRINT(label);
+    SERIAL_PRINT(": ");
+    SERIAL_PRINT(stats.shown);
+    SERIAL_PRINT(" frames, ");
+    SERIAL_PRINT(stats.dropped);
+    SERIAL_PRINT(" dropped, jitter avg ");
+    SERIAL_PRINT(stats.shown ? stats.totalJitterMs / stats.shown : 0);
+    SERIAL_PRINT(" ms, max ");
+    SERIAL_PRINT(stats.maxJitterMs);
+    SERIAL_PRINTLN(" ms");
+}
@@ -0,0 +1,48 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <Arduino.h>
+
+struct FramePacingStats
+{
+    uint32_t shown;
+    uint32_t dropped;
+    unsigned long maxJitterMs;   // worst lateness of a shown frame against its deadline
+    unsigned long totalJitterMs;
+};
+
+// Deadline bookkeeping for animations whose frames carry their own delays.
+// Each deadline is the previous one plus that frame's delay, so scheduler
+// granularity never accumulates into drift. A frame whose display window has
+// already passed when it is reached is dropped instead of shown late.
+class FramePacer
+{
+public:
+    // Browsers show GIF frames with tiny or missing delays at 10 FPS; so do we
+    static const uint16_t MIN_DELAY_MS = 20;
+    static const uint16_t DEFAULT_DELAY_MS = 100;
+    // Consecutive drops allowed before giving up and resyncing to now
+    static const uint8_t MAX_DROPS_PER_FRAME = 8;
+
+    FramePacer();
+    static uint16_t normalizeDelay(int delayMs);
+
+    void start(unsigned long now);
+    bool due(unsigned long now) const;
+    unsigned long nextDeadline() const;
+
+    // True if the frame due now should be skipped because its delay has already elapsed
+    bool late(unsigned long now, uint16_t delayMs) const;
+    void drop(uint16_t delayMs);
+    void present(unsigned long now, uint16_t delayMs);
+
+    const FramePacingStats &getStats() const;
+    void logStats(const char *label) const;
+
+private:
+    unsigned long deadline;
+    uint8_t consecutiveDrops;
+    FramePacingStats stats;
+};
+
+#endif
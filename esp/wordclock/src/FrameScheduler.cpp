@@ -0,0 +1,135 @@
+#include "FrameScheduler.h"
+
+#if !defined(__LINUX__) && CONFIG_PM_ENABLE && CONFIG_FREERTOS_USE_TICKLESS_IDLE
+#include <esp_pm.h>
+#include <esp_idf_version.h>
+#define FRAME_SCHEDULER_LIGHT_SLEEP 1
+#endif
+
+FrameScheduler::FrameScheduler(unsigned long frameBudgetMs, unsigned long idleIntervalMs)
+    : active(nullptr), frameBudgetMs(frameBudgetMs), idleIntervalMs(idleIntervalMs), idleDeadline(0), hasIdleDeadline(false), overruns(0) {}
+
+void FrameScheduler::begin()
+{
+#ifndef __LINUX__
+    renderTask = xTaskGetCurrentTaskHandle();
+#endif
+#ifdef FRAME_SCHEDULER_LIGHT_SLEEP
+    // Let the idle task enter light sleep while every task is blocked. The CPU
+    // clock stays fixed because the LED output timing depends on it.
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_pm_config_t pm = {};
+#else
+    esp_pm_config_esp32c3_t pm = {};
+#endif
+    pm.max_freq_mhz = getCpuFrequencyMhz();
+    pm.min_freq_mhz = getCpuFrequencyMhz();
+    pm.light_sleep_enable = true;
+    esp_pm_configure(&pm);
+#endif
+}
+
+void FrameScheduler::play(Animation *animation)
+{
+    active = animation;
+}
+
+void FrameScheduler::stop()
+{
+    active = nullptr;
+}
+
+bool FrameScheduler::isAnimating() const
+{
+    return active != nullptr;
+}
+
+bool FrameScheduler::tick(unsigned long now)
+{
+    if (active == nullptr)
+    {
+        return false;
+    }
+
+    active->tick(now);
+    if (active->done())
+    {
+        active = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void FrameScheduler::setIdleDeadline(unsigned long deadline)
+{
+    if (hasIdleDeadline && (long)(deadline - idleDeadline) >= 0)
+    {
+        return;
+    }
+    idleDeadline = deadline;
+    hasIdleDeadline = true;
+}
+
+void FrameScheduler::sleepUntilNextFrame(unsigned long frameStart)
+{
+    unsigned long period = isAnimating() ? frameBudgetMs : idleIntervalMs;
+    unsigned long now = millis();
+    unsigned long elapsed = now - frameStart;
+    bool useDeadline = isAnimating() || hasIdleDeadline;
+    unsigned long deadline = isAnimating() ? active->nextDeadline() : idleDeadline;
+    hasIdleDeadline = false;
+
+    if (elapsed >= period)
+    {
+        overruns++;
+        return;
+    }
+
+    unsigned long sleepMs = period - elapsed;
+    if (useDeadline)
+    {
+        long untilDeadline = (long)(deadline - now);
+        if (untilDeadline < 0)
+        {
+            untilDeadline = 0;
+        }
+        if ((unsigned long)untilDeadline < sleepMs)
+        {
+            sleepMs = untilDeadline;
+        }
+    }
+    sleep(sleepMs);
+}
+
+void FrameScheduler::sleep(unsigned long ms)
+{
+#ifdef __LINUX__
+    // Other tasks run inline on the host, so a wake can only be pending, never interrupt
+    if (wakePending)
+    {
+        wakePending = false;
+        return;
+    }
+    delay(ms);
+#else
+    // A notification given while awake is kept, so the next sleep returns at once
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+#endif
+}
+
+void FrameScheduler::wake()
+{
+#ifdef __LINUX__
+    wakePending = true;
+#else
+    if (renderTask != nullptr)
+    {
+        xTaskNotifyGive(renderTask);
+    }
+#endif
+}
+
+uint32_t FrameScheduler::getOverruns() const
+{
+    return overruns;
+}
@@ -0,0 +1,56 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Animation.h"
+
+// Cooperative scheduler driven from loop(). While an animation plays it ticks
+// it and sleeps out the rest of a fixed frame budget, ending early when the
+// animation's next frame is due sooner. With nothing animating it sleeps
+// until the idle deadline, e.g. the next phrase change, or until another
+// task calls wake().
+class FrameScheduler
+{
+public:
+    FrameScheduler(unsigned long frameBudgetMs, unsigned long idleIntervalMs);
+
+    // Call from the task that runs loop(), before the first sleep
+    void begin();
+
+    void play(Animation *animation);
+    void stop();
+    bool isAnimating() const;
+
+    // Ticks the active animation; returns true while it still owns the display
+    bool tick(unsigned long now);
+
+    // Next wake when nothing animates; the earliest of several calls wins and the
+    // idle interval caps it. Cleared by each sleep.
+    void setIdleDeadline(unsigned long deadline);
+
+    // Sleeps until the next frame starts or the animation's deadline, whichever is first;
+    // when idle, until the idle deadline or at most the idle interval
+    void sleepUntilNextFrame(unsigned long frameStart);
+
+    // Ends the current or next sleep early; safe to call from any task
+    void wake();
+
+    uint32_t getOverruns() const;
+
+private:
+    Animation *active;
+    unsigned long frameBudgetMs;
+    unsigned long idleIntervalMs;
+    unsigned long idleDeadline;
+    bool hasIdleDeadline;
+    uint32_t overruns;
+#ifdef __LINUX__
+    bool wakePending = false;
+#else
+    TaskHandle_t renderTask = nullptr;
+#endif
+
+    void sleep(unsigned long ms);
+};
+
+#endif
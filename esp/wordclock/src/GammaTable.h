@@ -0,0 +1,46 @@
+#ifndef GAMMA_TABLE_H
+#define GAMMA_TABLE_H
+
+#include <stdint.h>
+
+// LEDs are linear in PWM duty, eyes are not. This maps 8-bit colour values
+// through a 2.2 gamma curve to 16 bits, so brightness scaling and dithering
+// downstream keep the precision that dim colours need.
+
+struct Gamma16Table
+{
+    uint16_t values[256];
+};
+
+// x^2.2 as x^2 * x^(1/5), the fifth root by Newton's method; x in 0..1
+constexpr double gammaCurve(double x)
+{
+    if (x <= 0)
+    {
+        return 0;
+    }
+    double root = 1;
+    for (int i = 0; i < 60; ++i)
+    {
+        double root4 = root * root * root * root;
+        root = (4 * root + x / root4) / 5;
+    }
+    return x * x * root;
+}
+
+constexpr Gamma16Table buildGamma16Table()
+{
+    Gamma16Table table{};
+    for (int i = 0; i < 256; ++i)
+    {
+        table.values[i] = (uint16_t)(gammaCurve(i / 255.0) * 65535 + 0.5);
+    }
+    return table;
+}
+
+inline constexpr Gamma16Table GAMMA16 = buildGamma16Table();
+
+static_assert(GAMMA16.values[0] == 0 && GAMMA16.values[255] == 65535, "gamma curve endpoints");
+static_assert(GAMMA16.values[64] == 3131 && GAMMA16.values[128] == 14386, "gamma 2.2 midtones");
+
+#endif
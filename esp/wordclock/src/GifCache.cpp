@@ -0,0 +1,416 @@
+#include "GifCache.h"
+#include "SerialHelper.h"
+
+#define CACHE_DIR "/gifcache"
+#define CACHE_TEMP_PATH CACHE_DIR "/download.tmp"
+#define CACHE_STREAM_PATH CACHE_DIR "/stream.gif"
+#define CACHE_STREAM_CLIP_PATH CACHE_DIR "/stream.clip"
+#define CACHE_MAGIC 0x47494632 // "GIF2"
+
+GifCache::GifCache() : mounted(false), entries(), useCounter(0), path() {}
+
+bool GifCache::begin()
+{
+    if (!LittleFS.begin(true))
+    {
+        SERIAL_PRINTLN("LittleFS mount failed, GIF cache disabled.");
+        return false;
+    }
+    LittleFS.mkdir(CACHE_DIR);
+
+    // Index every entry whose metadata matches its GIF
+    File dir = LittleFS.open(CACHE_DIR);
+    while (File file = dir.openNextFile())
+    {
+        char *extension = nullptr;
+        uint32_t key = strtoul(file.name(), &extension, 16);
+        if (strcmp(extension, ".meta") != 0)
+        {
+            continue;
+        }
+
+        Metadata meta;
+        char gifPath[32];
+        entryPath(key, "gif", gifPath, sizeof(gifPath));
+        File gif = LittleFS.open(gifPath);
+        bool valid = file.read((uint8_t *)&meta, sizeof(meta)) == sizeof(meta) &&
+                     meta.magic == CACHE_MAGIC && gif && gif.size() == meta.size;
+        int slot = findEntry(0);
+        if (!valid || slot < 0)
+        {
+            continue;
+        }
+        entries[slot] = {key, meta.size, meta.lastUsed, true};
+        if (meta.lastUsed > useCounter)
+        {
+            useCounter = meta.lastUsed;
+        }
+    }
+    dir.close();
+    removeOrphans();
+
+    mounted = true;
+    SERIAL_PRINT("GIF cache: ");
+    SERIAL_PRINT(usedBytes());
+    SERIAL_PRINTLN(" bytes on flash");
+    return true;
+}
+
+const char *GifCache::fetch(const char *url)
+{
+    if (!mounted)
+    {
+        return nullptr;
+    }
+
+    uint32_t key = keyFor(url);
+    int index = findEntry(key);
+    Metadata meta;
+    bool cached = index >= 0 && readMetadata(key, meta) && strcmp(meta.url, url) == 0;
+    if (index >= 0 && !cached)
+    {
+        removeEntry(index);
+    }
+
+    // Serve from flash while the copy is fresh, or when there is no way to check it
+    uint32_t now = currentEpoch();
+    bool stale = !cached || (now != 0 && (now < meta.validatedAt || now - meta.validatedAt >= REVALIDATE_INTERVAL_SEC));
+    if (stale && WiFi.status() == WL_CONNECTED)
+    {
+        Download result = download(url, key, meta, cached);
+        if (result == Download::STREAMED)
+        {
+            snprintf(path, sizeof(path), "%s", CACHE_STREAM_PATH);
+            return path;
+        }
+        if (result == Download::FAILED && !cached)
+        {
+            return nullptr;
+        }
+    }
+    else if (!cached)
+    {
+        return nullptr;
+    }
+
+    index = findEntry(key);
+    if (index < 0)
+    {
+        return nullptr;
+    }
+    meta.lastUsed = ++useCounter;
+    entries[index].lastUsed = meta.lastUsed;
+    writeMetadata(key, meta);
+
+    entryPath(key, "gif", path, sizeof(path));
+    return path;
+}
+
+bool GifCache::contains(const char *url) const
+{
+    return mounted && findEntry(keyFor(url)) >= 0;
+}
+
+size_t GifCache::usedBytes() const
+{
+    size_t total = 0;
+    for (uint8_t i = 0; i < MAX_ENTRIES; ++i)
+    {
+        if (entries[i].used)
+        {
+            total += entries[i].size;
+        }
+    }
+    return total;
+}
+
+GifCache::Download GifCache::download(const char *url, uint32_t key, Metadata &meta, bool revalidate)
+{
+    HTTPClient http;
+    const char *headerKeys[] = {"ETag", "Last-Modified"};
+    http.collectHeaders(headerKeys, 2);
+    http.begin(url);
+    if (revalidate)
+    {
+        if (meta.etag[0] != '\0')
+        {
+            http.addHeader("If-None-Match", meta.etag);
+        }
+        else if (meta.lastModified[0] != '\0')
+        {
+            http.addHeader("If-Modified-Since", meta.lastModified);
+        }
+    }
+
+    int httpResponseCode = http.GET();
+    if (revalidate && httpResponseCode == HTTP_CODE_NOT_MODIFIED)
+    {
+        http.end();
+        SERIAL_PRINTLN("Cached GIF is up to date.");
+        meta.validatedAt = currentEpoch();
+        return Download::CACHED;
+    }
+    if (httpResponseCode != HTTP_CODE_OK)
+    {
+        http.end();
+        SERIAL_PRINT("GIF cache download failed: ");
+        SERIAL_PRINTLN(httpResponseCode);
+        return Download::FAILED;
+    }
+
+    // Nothing is evicted until the download is complete; until then it only needs
+    // free flash, whether it ends up cached or in the scratch file
+    int contentLength = http.getSize();
+    if (contentLength > 0 && (size_t)contentLength > LittleFS.totalBytes() - LittleFS.usedBytes())
+    {
+        http.end();
+        SERIAL_PRINTLN("GIF does not fit on flash.");
+        return Download::FAILED;
+    }
+
+    // Write to a temporary file so a failed download never replaces a good copy
+    File file = LittleFS.open(CACHE_TEMP_PATH, FILE_WRITE);
+    if (!file)
+    {
+        http.end();
+        return Download::FAILED;
+    }
+    int written = http.writeToStream(&file);
+    file.close();
+    String etag = http.header("ETag");
+    String lastModified = http.header("Last-Modified");
+    http.end();
+
+    if (written <= 0 || (contentLength > 0 && written != contentLength))
+    {
+        LittleFS.remove(CACHE_TEMP_PATH);
+        SERIAL_PRINTLN("GIF cache download incomplete.");
+        return Download::FAILED;
+    }
+    if ((size_t)written > MAX_BYTES || !makeRoom(written, key))
+    {
+        return keepStreamed(key) ? Download::STREAMED : Download::FAILED;
+    }
+
+    // Drop the clip decoded from the old copy before it can be paired with the new one
+    char gifPath[32];
+    entryPath(key, "clip", gifPath, sizeof(gifPath));
+    LittleFS.remove(gifPath);
+    entryPath(key, "gif", gifPath, sizeof(gifPath));
+    LittleFS.remove(gifPath);
+    if (!LittleFS.rename(CACHE_TEMP_PATH, gifPath))
+    {
+        LittleFS.remove(CACHE_TEMP_PATH);
+        return Download::FAILED;
+    }
+
+    memset(&meta, 0, sizeof(meta));
+    meta.magic = CACHE_MAGIC;
+    strncpy(meta.url, url, sizeof(meta.url) - 1);
+    if (!storeHeader(meta.etag, sizeof(meta.etag), etag.c_str()))
+    {
+        SERIAL_PRINTLN("ETag too long to cache, revalidating by date.");
+    }
+    storeHeader(meta.lastModified, sizeof(meta.lastModified), lastModified.c_str());
+    meta.size = written;
+    meta.validatedAt = currentEpoch();
+
+    int index = findEntry(key);
+    if (index < 0)
+    {
+        index = findEntry(0);
+    }
+    entries[index] = {key, (uint32_t)written, 0, true};
+
+    SERIAL_PRINT("Cached GIF (");
+    SERIAL_PRINT(written);
+    SERIAL_PRINTLN(" bytes).");
+    return Download::CACHED;
+}
+
+bool GifCache::keepStreamed(uint32_t key)
+{
+    // Whatever the cache held for this URL is outdated now
+    int index = findEntry(key);
+    if (index >= 0)
+    {
+        removeEntry(index);
+    }
+
+    LittleFS.remove(CACHE_STREAM_CLIP_PATH);
+    LittleFS.remove(CACHE_STREAM_PATH);
+    if (!LittleFS.rename(CACHE_TEMP_PATH, CACHE_STREAM_PATH))
+    {
+        LittleFS.remove(CACHE_TEMP_PATH);
+        return false;
+    }
+    SERIAL_PRINTLN("GIF too large to cache, playing it from a scratch file.");
+    return true;
+}
+
+bool GifCache::storeHeader(char *field, size_t size, const char *value)
+{
+    size_t length = strlen(value);
+    if (length >= size)
+    {
+        field[0] = '\0';
+        return false;
+    }
+    memcpy(field, value, length + 1);
+    return true;
+}
+
+bool GifCache::makeRoom(size_t bytes, uint32_t keep)
+{
+    while (true)
+    {
+        size_t total = 0;
+        uint8_t count = 0;
+        int oldest = -1;
+        for (uint8_t i = 0; i < MAX_ENTRIES; ++i)
+        {
+            if (!entries[i].used || entries[i].key == keep)
+            {
+                continue;
+            }
+            total += entries[i].size;
+            count++;
+            if (oldest < 0 || entries[i].lastUsed < entries[oldest].lastUsed)
+            {
+                oldest = i;
+            }
+        }
+
+        // The entry being written needs its own slot as well as the bytes
+        if (total + bytes <= MAX_BYTES && count < MAX_ENTRIES)
+        {
+            return true;
+        }
+        if (oldest < 0)
+        {
+            return false;
+        }
+        SERIAL_PRINTLN("Evicting least recently used GIF from cache.");
+        removeEntry(oldest);
+    }
+}
+
+void GifCache::removeOrphans()
+{
+    // Anything no indexed entry owns: invalid entries, GIFs or clips whose metadata
+    // is gone (a reset between writing the two), the last boot's scratch file and
+    // download. Listed first and removed after, a pass at a time.
+    while (true)
+    {
+        char orphans[MAX_ENTRIES][32];
+        uint8_t orphanCount = 0;
+        File dir = LittleFS.open(CACHE_DIR);
+        while (orphanCount < MAX_ENTRIES)
+        {
+            File file = dir.openNextFile();
+            if (!file)
+            {
+                break;
+            }
+            char *extension = nullptr;
+            uint32_t key = strtoul(file.name(), &extension, 16);
+            bool owned = key != 0 && findEntry(key) >= 0 && extension == file.name() + 8 &&
+                         (strcmp(extension, ".gif") == 0 || strcmp(extension, ".meta") == 0 ||
+                          strcmp(extension, ".clip") == 0);
+            if (!owned)
+            {
+                snprintf(orphans[orphanCount++], sizeof(orphans[0]), CACHE_DIR "/%s", file.name());
+            }
+        }
+        dir.close();
+
+        uint8_t removed = 0;
+        for (uint8_t i = 0; i < orphanCount; ++i)
+        {
+            removed += LittleFS.remove(orphans[i]) ? 1 : 0;
+        }
+        // Done once a pass comes up short, or stuck on files that won't go
+        if (orphanCount < MAX_ENTRIES || removed == 0)
+        {
+            return;
+        }
+    }
+}
+
+void GifCache::removeEntry(int index)
+{
+    char stalePath[32];
+    entryPath(entries[index].key, "gif", stalePath, sizeof(stalePath));
+    LittleFS.remove(stalePath);
+    entryPath(entries[index].key, "meta", stalePath, sizeof(stalePath));
+    LittleFS.remove(stalePath);
+    entryPath(entries[index].key, "clip", stalePath, sizeof(stalePath));
+    LittleFS.remove(stalePath);
+    entries[index] = {};
+}
+
+void GifCache::clipPathFor(const char *gifPath, char *buffer, size_t size)
+{
+    snprintf(buffer, size, "%s", gifPath);
+    char *extension = strrchr(buffer, '.');
+    if (extension != nullptr)
+    {
+        snprintf(extension, size - (extension - buffer), ".clip");
+    }
+}
+
+int GifCache::findEntry(uint32_t key) const
+{
+    // key 0 finds a free slot
+    for (uint8_t i = 0; i < MAX_ENTRIES; ++i)
+    {
+        if (key == 0 ? !entries[i].used : entries[i].used && entries[i].key == key)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool GifCache::readMetadata(uint32_t key, Metadata &meta)
+{
+    char metaPath[32];
+    entryPath(key, "meta", metaPath, sizeof(metaPath));
+    File file = LittleFS.open(metaPath);
+    return file && file.read((uint8_t *)&meta, sizeof(meta)) == sizeof(meta) && meta.magic == CACHE_MAGIC;
+}
+
+bool GifCache::writeMetadata(uint32_t key, const Metadata &meta)
+{
+    char metaPath[32];
+    entryPath(key, "meta", metaPath, sizeof(metaPath));
+    File file = LittleFS.open(metaPath, FILE_WRITE);
+    return file && file.write((const uint8_t *)&meta, sizeof(meta)) == sizeof(meta);
+}
+
+uint32_t GifCache::keyFor(const char *url)
+{
+    // FNV-1a; 0 is reserved for free slots
+    uint32_t hash = 2166136261u;
+    while (*url)
+    {
+        hash = (hash ^ (uint8_t)*url++) * 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+void GifCache::entryPath(uint32_t key, const char *extension, char *buffer, size_t size)
+{
+    snprintf(buffer, size, CACHE_DIR "/%08lx.%s", (unsigned long)key, extension);
+}
+
+uint32_t GifCache::currentEpoch()
+{
+    // 0 until NTP has set the clock
+    struct tm timeinfo;
+    if (!getLocalTime(&timeinfo, 0))
+    {
+        return 0;
+    }
+    return mktime(&timeinfo);
+}
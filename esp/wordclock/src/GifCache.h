@@ -0,0 +1,85 @@
+#ifndef GIF_CACHE_H
+#define GIF_CACHE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <HTTPClient.h>
+
+// GIFs kept on the LittleFS partition keyed by URL, so the hourly animation
+// plays from flash instead of the network. A cached copy is revalidated with
+// If-None-Match / If-Modified-Since at most once per REVALIDATE_INTERVAL_SEC,
+// and the least recently played entries are evicted to stay under MAX_BYTES.
+// Downloads stream to flash through a small buffer, so the heap never holds a
+// whole GIF; one too large for the cache is kept uncached in a scratch file
+// that the next such download replaces.
+class GifCache
+{
+public:
+    static const size_t MAX_BYTES = 256 * 1024;
+    static const uint8_t MAX_ENTRIES = 16;
+    static const uint32_t REVALIDATE_INTERVAL_SEC = 86400;
+
+    GifCache();
+    // Mounts the filesystem (formatting it if needed) and indexes existing entries
+    bool begin();
+
+    // Makes url available on flash, downloading or revalidating it as needed.
+    // Returns the cached (or scratch) file's path, or nullptr if there is no usable copy.
+    const char *fetch(const char *url);
+    bool contains(const char *url) const;
+    // Where the decoded clip of a cached GIF is kept; removed with the GIF
+    static void clipPathFor(const char *gifPath, char *buffer, size_t size);
+    size_t usedBytes() const;
+    // Copies a response header into a metadata field; one too long to fit is not
+    // stored at all, since a truncated validator would never match.
+    static bool storeHeader(char *field, size_t size, const char *value);
+
+private:
+    struct Metadata
+    {
+        uint32_t magic;
+        char url[160];
+        char etag[96]; // a quoted 64-hex-digit hash, with room for W/
+        char lastModified[32];
+        uint32_t size;
+        uint32_t validatedAt; // epoch seconds of the last 200 or 304
+        uint32_t lastUsed;    // LRU sequence number
+    };
+
+    enum class Download : uint8_t
+    {
+        FAILED,
+        CACHED,
+        STREAMED // too large for the cache, left in the scratch file
+    };
+
+    struct Entry
+    {
+        uint32_t key;
+        uint32_t size;
+        uint32_t lastUsed;
+        bool used;
+    };
+
+    bool mounted;
+    Entry entries[MAX_ENTRIES];
+    uint32_t useCounter;
+    char path[32];
+
+    static uint32_t keyFor(const char *url);
+    static void entryPath(uint32_t key, const char *extension, char *buffer, size_t size);
+    static uint32_t currentEpoch();
+    int findEntry(uint32_t key) const;
+    bool readMetadata(uint32_t key, Metadata &meta);
+    bool writeMetadata(uint32_t key, const Metadata &meta);
+    Download download(const char *url, uint32_t key, Metadata &meta, bool revalidate);
+    // Moves a completed download that the cache can't hold into the scratch file
+    bool keepStreamed(uint32_t key);
+    bool makeRoom(size_t bytes, uint32_t keep);
+    // Removes files in the cache directory that no indexed entry owns
+    void removeOrphans();
+    void removeEntry(int index);
+};
+
+#endif
@@ -0,0 +1,315 @@
+#include "GifClip.h"
+#include <FS.h>
+#include <LittleFS.h>
+
+// Frames are encoded after a full-size palette and moved down once its size is known
+#define FRAMES_START (HEADER_SIZE + MAX_PALETTE * 3)
+
+GifClip::GifClip()
+    : data(nullptr), size(0), valid(false), cursor(0), rgb(false), overflowed(false), frameCount(0), paletteSize(0), palette{}, previous{}
+{
+}
+
+GifClip::~GifClip()
+{
+    free(data);
+}
+
+bool GifClip::allocate()
+{
+    if (data == nullptr)
+    {
+        data = (uint8_t *)malloc(MAX_BYTES);
+    }
+    return data != nullptr;
+}
+
+void GifClip::beginEncode(bool encodeRGB)
+{
+    valid = false;
+    rgb = encodeRGB;
+    overflowed = false;
+    frameCount = 0;
+    paletteSize = 0;
+    size = FRAMES_START;
+}
+
+bool GifClip::addFrame(const uint8_t *canvas, uint16_t delayMs)
+{
+    if (!allocate() || overflowed || frameCount == UINT16_MAX)
+    {
+        return false;
+    }
+
+    uint8_t changed = 0;
+    bool key = frameCount == 0;
+    if (!key)
+    {
+        uint16_t count = 0;
+        for (uint16_t i = 0; i < PIXELS; ++i)
+        {
+            if (memcmp(&canvas[i * 3], &previous[i * 3], 3) != 0)
+            {
+                count++;
+            }
+        }
+        // A delta pays an index byte per pixel, so it only wins for sparse changes
+        key = count > UINT8_MAX || count * (1 + pixelSize()) >= PIXELS * pixelSize();
+        changed = key ? 0 : count;
+    }
+
+    size_t offset = size;
+    size_t needed = 3 + (key ? PIXELS * pixelSize() : 1 + changed * (1 + pixelSize()));
+    if (offset + needed > MAX_BYTES)
+    {
+        return false;
+    }
+
+    data[offset++] = delayMs & 0xFF;
+    data[offset++] = delayMs >> 8;
+    data[offset++] = key ? FRAME_KEY : FRAME_DELTA;
+    if (key)
+    {
+        for (uint16_t i = 0; i < PIXELS; ++i)
+        {
+            if (!writePixel(offset, &canvas[i * 3]))
+                return false;
+        }
+    }
+    else
+    {
+        data[offset++] = changed;
+        for (uint16_t i = 0; i < PIXELS; ++i)
+        {
+            if (memcmp(&canvas[i * 3], &previous[i * 3], 3) != 0)
+            {
+                data[offset++] = i;
+                if (!writePixel(offset, &canvas[i * 3]))
+                    return false;
+            }
+        }
+    }
+
+    memcpy(previous, canvas, sizeof(previous));
+    size = offset;
+    frameCount++;
+    return true;
+}
+
+bool GifClip::endEncode()
+{
+    if (data == nullptr || frameCount == 0)
+    {
+        return false;
+    }
+
+    size_t paletteBytes = paletteSize * 3;
+    size_t frameBytes = size - FRAMES_START;
+    memmove(&data[HEADER_SIZE + paletteBytes], &data[FRAMES_START], frameBytes);
+    memcpy(&data[HEADER_SIZE], palette, paletteBytes);
+
+    memcpy(data, "WCLP", 4);
+    data[4] = VERSION;
+    data[5] = ClockDisplayHAL::WIDTH;
+    data[6] = ClockDisplayHAL::HEIGHT;
+    data[7] = rgb ? FLAG_RGB : 0;
+    data[8] = frameCount & 0xFF;
+    data[9] = frameCount >> 8;
+    data[10] = paletteSize & 0xFF;
+    data[11] = paletteSize >> 8;
+
+    size = HEADER_SIZE + paletteBytes + frameBytes;
+    valid = true;
+    rewind();
+    return true;
+}
+
+bool GifClip::paletteOverflowed() const
+{
+    return overflowed;
+}
+
+bool GifClip::load(const char *path)
+{
+    valid = false;
+    File file = LittleFS.open(path);
+    if (!file || file.size() < HEADER_SIZE || file.size() > MAX_BYTES || !allocate())
+    {
+        return false;
+    }
+
+    size = file.read(data, file.size());
+    if (size != file.size() || memcmp(data, "WCLP", 4) != 0 || data[4] != VERSION ||
+        data[5] != ClockDisplayHAL::WIDTH || data[6] != ClockDisplayHAL::HEIGHT)
+    {
+        return false;
+    }
+
+    rgb = data[7] & FLAG_RGB;
+    frameCount = data[8] | (data[9] << 8);
+    paletteSize = data[10] | (data[11] << 8);
+    valid = frameCount > 0 && paletteSize <= MAX_PALETTE && framesFit();
+    rewind();
+    return valid;
+}
+
+bool GifClip::framesFit() const
+{
+    // Walked once here so playback can read without bounds checks: every frame must
+    // be complete, index the palette and LEDs in range, and the last end the file
+    size_t offset = HEADER_SIZE + paletteSize * 3;
+    for (uint16_t frame = 0; frame < frameCount; ++frame)
+    {
+        if (offset + 3 > size)
+        {
+            return false;
+        }
+        uint8_t type = data[offset + 2];
+        offset += 3;
+        uint16_t count = PIXELS;
+        if (type == FRAME_DELTA && frame > 0 && offset < size)
+        {
+            count = data[offset++];
+        }
+        else if (type != FRAME_KEY)
+        {
+            return false;
+        }
+
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            if (type == FRAME_DELTA && (offset >= size || data[offset++] >= PIXELS))
+            {
+                return false;
+            }
+            if (offset + pixelSize() > size || (!rgb && data[offset] >= paletteSize))
+            {
+                return false;
+            }
+            offset += pixelSize();
+        }
+    }
+    return offset == size;
+}
+
+bool GifClip::save(const char *path) const
+{
+    if (!valid)
+    {
+        return false;
+    }
+
+    // Write beside the old clip and swap it in, so a reset mid-write never leaves half a clip
+    char tempPath[40];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    File file = LittleFS.open(tempPath, FILE_WRITE);
+    if (!file)
+    {
+        return false;
+    }
+    bool written = file.write(data, size) == size;
+    file.close();
+    LittleFS.remove(path);
+    if (!written || !LittleFS.rename(tempPath, path))
+    {
+        LittleFS.remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+bool GifClip::isValid() const
+{
+    return valid;
+}
+
+uint16_t GifClip::getFrameCount() const
+{
+    return valid ? frameCount : 0;
+}
+
+size_t GifClip::getSize() const
+{
+    return valid ? size : 0;
+}
+
+void GifClip::rewind()
+{
+    cursor = HEADER_SIZE + paletteSize * 3;
+}
+
+bool GifClip::nextFrame(uint8_t *canvas, uint16_t &delayMs)
+{
+    if (!valid || cursor + 3 > size)
+    {
+        return false;
+    }
+
+    const uint8_t *frame = &data[cursor];
+    delayMs = frame[0] | (frame[1] << 8);
+    const uint8_t *pixel = &frame[3];
+    if (frame[2] == FRAME_KEY)
+    {
+        for (uint16_t i = 0; i < PIXELS; ++i, pixel += pixelSize())
+        {
+            memcpy(&canvas[i * 3], pixelColor(pixel), 3);
+        }
+    }
+    else
+    {
+        uint8_t count = *pixel++;
+        for (uint8_t i = 0; i < count; ++i, pixel += pixelSize())
+        {
+            uint8_t index = *pixel++;
+            memcpy(&canvas[index * 3], pixelColor(pixel), 3);
+        }
+    }
+    cursor = pixel - data;
+    return true;
+}
+
+int GifClip::paletteIndex(const uint8_t *color)
+{
+    for (uint16_t i = 0; i < paletteSize; ++i)
+    {
+        if (memcmp(&palette[i * 3], color, 3) == 0)
+        {
+            return i;
+        }
+    }
+    if (paletteSize == MAX_PALETTE)
+    {
+        return -1;
+    }
+    memcpy(&palette[paletteSize * 3], color, 3);
+    return paletteSize++;
+}
+
+bool GifClip::writePixel(size_t &offset, const uint8_t *color)
+{
+    if (rgb)
+    {
+        memcpy(&data[offset], color, 3);
+        offset += 3;
+        return true;
+    }
+
+    int index = paletteIndex(color);
+    if (index < 0)
+    {
+        overflowed = true;
+        return false;
+    }
+    data[offset++] = index;
+    return true;
+}
+
+const uint8_t *GifClip::pixelColor(const uint8_t *pixel) const
+{
+    return rgb ? pixel : &data[HEADER_SIZE + *pixel * 3];
+}
+
+uint8_t GifClip::pixelSize() const
+{
+    return rgb ? 3 : 1;
+}
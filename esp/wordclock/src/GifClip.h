@@ -0,0 +1,79 @@
+#ifndef GIF_CLIP_H
+#define GIF_CLIP_H
+
+#include <Arduino.h>
+#include "ClockDisplayHAL.h"
+
+/*
+A GIF decoded once into frames already sized for the display, so playback is
+a table lookup per pixel with no LZW state. Layout, little-endian:
+
+  header   "WCLP", version, width, height, flags, frameCount (u16), paletteSize (u16)
+  palette  paletteSize x RGB888
+  frames   delayMs (u16), type, then
+             KEY:   width*height pixels
+             DELTA: count (u8), count x (pixel index, pixel)
+
+A pixel is a palette index, or RGB888 when FLAG_RGB is set because the GIF
+used more than 256 colours. A DELTA frame lists only pixels that changed
+since the previous frame; the first frame is always a KEY frame.
+*/
+class GifClip
+{
+public:
+    static const size_t MAX_BYTES = 16384;
+    static const uint16_t PIXELS = ClockDisplayHAL::NUM_LEDS;
+    static const uint16_t MAX_PALETTE = 256;
+
+    GifClip();
+    ~GifClip();
+
+    // Encoding: frames are row-major RGB888 canvases of PIXELS * 3 bytes
+    void beginEncode(bool rgb);
+    bool addFrame(const uint8_t *canvas, uint16_t delayMs);
+    bool endEncode();
+    // True if the last encode failed because the GIF needs RGB frames
+    bool paletteOverflowed() const;
+
+    // A damaged or truncated file fails to load rather than playing out of bounds
+    bool load(const char *path);
+    bool save(const char *path) const;
+
+    bool isValid() const;
+    uint16_t getFrameCount() const;
+    size_t getSize() const;
+
+    // Playback: applies the next frame to an RGB888 canvas; false after the last frame
+    void rewind();
+    bool nextFrame(uint8_t *canvas, uint16_t &delayMs);
+
+private:
+    static const uint8_t HEADER_SIZE = 12;
+    static const uint8_t VERSION = 1;
+    static const uint8_t FLAG_RGB = 0x01;
+    static const uint8_t FRAME_KEY = 0;
+    static const uint8_t FRAME_DELTA = 1;
+
+    // Allocated once on first use and reused afterwards
+    uint8_t *data;
+    size_t size;
+    bool valid;
+    size_t cursor;
+
+    // Encoder state
+    bool rgb;
+    bool overflowed;
+    uint16_t frameCount;
+    uint16_t paletteSize;
+    uint8_t palette[MAX_PALETTE * 3];
+    uint8_t previous[PIXELS * 3];
+
+    bool allocate();
+    bool framesFit() const;
+    int paletteIndex(const uint8_t *color);
+    bool writePixel(size_t &offset, const uint8_t *color);
+    const uint8_t *pixelColor(const uint8_t *pixel) const;
+    uint8_t pixelSize() const;
+};
+
+#endif
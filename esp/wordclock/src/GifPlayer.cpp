@@ -4,7 +4,8 @@
 GifPlayer *GifPlayer::instance = nullptr;
 
 GifPlayer::GifPlayer(ClockDisplayHAL *clockDisplayHAL)
-    : clockDisplayHAL(clockDisplayHAL), storedBuffer(nullptr), storedSize(0), gifLoaded(false)
+    : clockDisplayHAL(clockDisplayHAL), canvas{}, frameComplete(false), filePath(), storedBuffer(nullptr), storedSize(0), gifLoaded(false),
+      playing(false), startTime(0), durationMs(0)
 {
     gif.begin(GIF_PALETTE_RGB888);
     instance = this;
@@ -12,97 +13,266 @@ GifPlayer::GifPlayer(ClockDisplayHAL *clockDisplayHAL)
 
 void GifPlayer::GIFDraw(GIFDRAW *pDraw)
 {
-    if (instance && instance->clockDisplayHAL)
+    if (instance == nullptr)
     {
-        ClockDisplayHAL *hal = instance->clockDisplayHAL;
+        return;
+    }
 
-        uint8_t r, g, b, *s, *p, *pPal = (uint8_t *)pDraw->pPalette;
-        int x, y = pDraw->iY + pDraw->y;
+    // Rows below the display are skipped, but the GIF's last row still ends the frame
+    if (pDraw->y == pDraw->iHeight - 1)
+    {
+        instance->frameComplete = true;
+    }
 
-        s = pDraw->pPixels;
-        if (pDraw->ucDisposalMethod == 2)
+    uint8_t *s, *p, *pPal = (uint8_t *)pDraw->pPalette;
+    int x, y = pDraw->iY + pDraw->y;
+    if (y >= ClockDisplayHAL::HEIGHT)
+    {
+        return;
+    }
+    uint8_t *row = &instance->canvas[y * ClockDisplayHAL::WIDTH * 3];
+    int width = pDraw->iWidth;
+    if (pDraw->iX + width > ClockDisplayHAL::WIDTH)
+    {
+        width = ClockDisplayHAL::WIDTH - pDraw->iX;
+    }
+
+    s = pDraw->pPixels;
+    if (pDraw->ucDisposalMethod == 2)
+    {
+        p = &pPal[pDraw->ucBackground * 3];
+        for (x = 0; x < width; x++)
         {
-            p = &pPal[pDraw->ucBackground * 3];
-            r = p[0] >> BRIGHT_SHIFT;
-            g = p[1] >> BRIGHT_SHIFT;
-            b = p[2] >> BRIGHT_SHIFT;
-            for (x = 0; x < pDraw->iWidth; x++)
+            if (s[x] == pDraw->ucTransparent)
             {
-                if (s[x] == pDraw->ucTransparent)
-                {
-                    hal->setPixel(x, y, hal->pixels.Color(r, g, b));
-                }
+                uint8_t *d = &row[(pDraw->iX + x) * 3];
+                d[0] = p[0] >> BRIGHT_SHIFT;
+                d[1] = p[1] >> BRIGHT_SHIFT;
+                d[2] = p[2] >> BRIGHT_SHIFT;
             }
-            pDraw->ucHasTransparency = 0;
         }
+        pDraw->ucHasTransparency = 0;
+    }
 
-        if (pDraw->ucHasTransparency)
+    for (x = 0; x < width; x++)
+    {
+        if (pDraw->ucHasTransparency && s[x] == pDraw->ucTransparent)
         {
-            const uint8_t ucTransparent = pDraw->ucTransparent;
-            for (x = 0; x < pDraw->iWidth; x++)
-            {
-                if (s[x] != ucTransparent)
-                {
-                    p = &pPal[s[x] * 3];
-                    hal->setPixel(x, y, hal->pixels.Color(p[0] >> BRIGHT_SHIFT, p[1] >> BRIGHT_SHIFT, p[2] >> BRIGHT_SHIFT));
-                }
-            }
+            continue;
         }
-        else
+        p = &pPal[s[x] * 3];
+        uint8_t *d = &row[(pDraw->iX + x) * 3];
+        d[0] = p[0] >> BRIGHT_SHIFT;
+        d[1] = p[1] >> BRIGHT_SHIFT;
+        d[2] = p[2] >> BRIGHT_SHIFT;
+    }
+}
+
+void GifPlayer::showCanvas()
+{
+    clockDisplayHAL->blitFrame(canvas);
+    clockDisplayHAL->show();
+}
+
+bool GifPlayer::decodeToClip(GifClip &clip)
+{
+    if (!gifLoaded)
+    {
+        return false;
+    }
+
+    // Palette frames first; a GIF with more than 256 colours is re-encoded as RGB
+    bool encoded = false;
+    for (int attempt = 0; attempt < 2 && !encoded; ++attempt)
+    {
+        gif.reset();
+        memset(canvas, 0, sizeof(canvas));
+        clip.beginEncode(attempt == 1);
+
+        bool ok = true;
+        int rc;
+        do
         {
-            for (x = 0; x < pDraw->iWidth; x++)
+            int frameDelayMs = 0;
+            frameComplete = false;
+            rc = gif.playFrame(false, &frameDelayMs);
+            if (rc < 0 || (frameComplete && !clip.addFrame(canvas, frameDelayMs)))
             {
-                p = &pPal[s[x] * 3];
-                hal->setPixel(x, y, hal->pixels.Color(p[0] >> BRIGHT_SHIFT, p[1] >> BRIGHT_SHIFT, p[2] >> BRIGHT_SHIFT));
+                ok = false;
+                break;
             }
-        }
+        } while (rc > 0);
 
-        if (pDraw->y == pDraw->iHeight - 1)
+        encoded = ok && clip.endEncode();
+        if (!encoded && !clip.paletteOverflowed())
         {
-            hal->show();
+            break;
         }
     }
+
+    gif.reset();
+    memset(canvas, 0, sizeof(canvas));
+    return encoded;
+}
+
+void *GifPlayer::GIFOpenFile(const char *szFilename, int32_t *pFileSize)
+{
+    File *file = &instance->file;
+    *file = LittleFS.open(szFilename);
+    if (!*file)
+    {
+        return nullptr;
+    }
+    *pFileSize = file->size();
+    return file;
+}
+
+void GifPlayer::GIFCloseFile(void *pHandle)
+{
+    static_cast<File *>(pHandle)->close();
+}
+
+int32_t GifPlayer::GIFReadFile(GIFFILE *pFile, uint8_t *pBuf, int32_t iLen)
+{
+    File *file = static_cast<File *>(pFile->fHandle);
+    if (iLen > pFile->iSize - pFile->iPos)
+        iLen = pFile->iSize - pFile->iPos;
+    if (iLen <= 0)
+        return 0;
+    // Seek explicitly: the decoder may have moved iPos without calling back
+    file->seek(pFile->iPos);
+    int32_t bytesRead = file->read(pBuf, iLen);
+    pFile->iPos += bytesRead;
+    return bytesRead;
+}
+
+int32_t GifPlayer::GIFSeekFile(GIFFILE *pFile, int32_t iPosition)
+{
+    if (iPosition < 0)
+        iPosition = 0;
+    if (iPosition > pFile->iSize)
+        iPosition = pFile->iSize;
+    pFile->iPos = iPosition;
+    return iPosition;
 }
 
 bool GifPlayer::loadGIF(uint8_t *gifBuffer, size_t gifSize)
 {
+    if (gifLoaded)
+    {
+        gif.close();
+    }
+
     // Store buffer reference for later replay
     storedBuffer = gifBuffer;
     storedSize = gifSize;
+    filePath[0] = '\0';
 
     int rc = gif.open(gifBuffer, gifSize, GIFDraw);
     gifLoaded = (rc != 0);
     return gifLoaded;
 }
 
+bool GifPlayer::loadFile(const char *path)
+{
+    if (gifLoaded)
+    {
+        gif.close();
+    }
+
+    storedBuffer = nullptr;
+    storedSize = 0;
+    strncpy(filePath, path, sizeof(filePath) - 1);
+    filePath[sizeof(filePath) - 1] = '\0';
+
+    int rc = gif.open(filePath, GIFOpenFile, GIFCloseFile, GIFReadFile, GIFSeekFile, GIFDraw);
+    gifLoaded = (rc != 0);
+    return gifLoaded;
+}
+
 bool GifPlayer::reopenGIF()
 {
-    if (storedBuffer == nullptr || storedSize == 0)
+    int rc = 0;
+    if (filePath[0] != '\0')
     {
-        return false;
+        rc = gif.open(filePath, GIFOpenFile, GIFCloseFile, GIFReadFile, GIFSeekFile, GIFDraw);
+    }
+    else if (storedBuffer != nullptr && storedSize > 0)
+    {
+        rc = gif.open(storedBuffer, storedSize, GIFDraw);
     }
-    int rc = gif.open(storedBuffer, storedSize, GIFDraw);
     return (rc != 0);
 }
 
-void GifPlayer::playGIF(unsigned long durationMs)
+bool GifPlayer::begin(unsigned long newDurationMs)
 {
     // Reopen GIF if it was previously closed
     if (!gifLoaded && !reopenGIF())
+    {
+        return false;
+    }
+
+    gifLoaded = true;
+    playing = true;
+    durationMs = newDurationMs;
+    startTime = millis();
+    pacer.start(startTime);
+    return true;
+}
+
+void GifPlayer::tick(unsigned long now)
+{
+    if (!playing)
     {
         return;
     }
 
-    unsigned long startTime = millis();
+    if (now - startTime >= durationMs)
+    {
+        gif.close();
+        gifLoaded = false;  // Mark as closed so we reopen next time
+        playing = false;
+        pacer.logStats("GIF");
+        return;
+    }
 
-    while (millis() - startTime < durationMs)
+    if (!pacer.due(now))
     {
-        if (!gif.playFrame(true, nullptr))
-        {
-            gif.reset();
-        }
+        return;
+    }
+
+    // Frames depend on their predecessors, so late ones are decoded but not shown
+    uint16_t frameDelayMs = decodeNextFrame();
+    while (pacer.late(now, frameDelayMs))
+    {
+        pacer.drop(frameDelayMs);
+        frameDelayMs = decodeNextFrame();
+    }
+    showCanvas();
+    pacer.present(now, frameDelayMs);
+}
+
+uint16_t GifPlayer::decodeNextFrame()
+{
+    int frameDelayMs = 0;
+    if (!gif.playFrame(false, &frameDelayMs))
+    {
+        gif.reset();
     }
+    return FramePacer::normalizeDelay(frameDelayMs);
+}
 
-    gif.close();
-    gifLoaded = false;  // Mark as closed so we reopen next time
+bool GifPlayer::done() const
+{
+    return !playing;
+}
+
+unsigned long GifPlayer::nextDeadline() const
+{
+    return pacer.nextDeadline();
+}
+
+const FramePacingStats &GifPlayer::getPacingStats() const
+{
+    return pacer.getStats();
 }
@@ -3,25 +3,60 @@
 
 #include <Arduino.h>
 #include <AnimatedGIF.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include "Animation.h"
 #include "ClockDisplayHAL.h"
+#include "GifClip.h"
+#include "FramePacer.h"
 
-class GifPlayer
+class GifPlayer : public Animation
 {
 public:
     GifPlayer(ClockDisplayHAL *clockDisplayHAL);
     bool loadGIF(uint8_t *gifBuffer, size_t gifSize);
-    void playGIF(unsigned long durationMs);
+    // Decodes from a file on LittleFS, reading it in place rather than into RAM
+    bool loadFile(const char *path);
+
+    // Decodes one loop of the loaded GIF into a clip that plays without the decoder
+    bool decodeToClip(GifClip &clip);
+
+    // Starts playback of the loaded GIF; frames are rendered from tick()
+    bool begin(unsigned long durationMs);
+    void tick(unsigned long now) override;
+    bool done() const override;
+    unsigned long nextDeadline() const override;
+    const FramePacingStats &getPacingStats() const;
 
 private:
     ClockDisplayHAL *clockDisplayHAL;
     AnimatedGIF gif;
     static void GIFDraw(GIFDRAW *pDraw);
 
+    // Frames are composed here, clipped to the display, then shown or encoded
+    uint8_t canvas[ClockDisplayHAL::NUM_LEDS * 3];
+    bool frameComplete;
+    void showCanvas();
+    uint16_t decodeNextFrame();
+
+    // AnimatedGIF file callbacks backed by a LittleFS file
+    File file;
+    char filePath[32];
+    static void *GIFOpenFile(const char *szFilename, int32_t *pFileSize);
+    static void GIFCloseFile(void *pHandle);
+    static int32_t GIFReadFile(GIFFILE *pFile, uint8_t *pBuf, int32_t iLen);
+    static int32_t GIFSeekFile(GIFFILE *pFile, int32_t iPosition);
+
     // Store buffer reference for replay capability
     uint8_t *storedBuffer;
     size_t storedSize;
     bool gifLoaded;
 
+    bool playing;
+    unsigned long startTime;
+    unsigned long durationMs;
+    FramePacer pacer;
+
     bool reopenGIF();
 
     static GifPlayer *instance;
@@ -2,58 +2,94 @@
 #include "SerialHelper.h"
 
 #define MAX_GIF_SIZE 32768 // 32KB limit
+#define DOWNLOAD_TIMEOUT_MS 5000 // Give up after this long without data
 
 WiFiTimeManager::WiFiTimeManager(char *ssid, char *password, long gmtOffset_sec, int daylightOffset_sec)
-    : ssid(ssid), password(password), gmtOffset_sec(gmtOffset_sec), daylightOffset_sec(daylightOffset_sec), lastSyncTime(0), gifBuffer(nullptr), gifBufferSize(0) {}
+    : ssid(ssid), password(password), gmtOffset_sec(gmtOffset_sec), daylightOffset_sec(daylightOffset_sec), lastSyncTime(0), lastReconnectAttempt(0), connected(false), synced(false), gifBuffer(nullptr), gifBufferSize(0) {}
 
 void WiFiTimeManager::setup()
 {
     WiFi.begin(ssid, password);
-    while (WiFi.status() != WL_CONNECTED)
-    {
-        delay(500);
-        SERIAL_PRINT(".");
-    }
-    SERIAL_PRINTLN("WiFi connected");
-
-    syncTimeWithNTP();
+    lastReconnectAttempt = millis();
 }
 
 void WiFiTimeManager::update()
 {
     unsigned long currentMillis = millis();
+    if (WiFi.status() != WL_CONNECTED)
+    {
+        if (connected)
+        {
+            SERIAL_PRINTLN("WiFi connection lost");
+            connected = false;
+        }
+        if (currentMillis - lastReconnectAttempt >= reconnectInterval)
+        {
+            WiFi.reconnect();
+            lastReconnectAttempt = currentMillis;
+        }
+        return;
+    }
+
+    if (!connected)
+    {
+        SERIAL_PRINTLN("WiFi connected");
+        connected = true;
+        if (!synced)
+        {
+            syncTimeWithNTP();
+        }
+    }
+
     if (currentMillis - lastSyncTime >= syncInterval)
     {
         syncTimeWithNTP();
     }
 }
 
+bool WiFiTimeManager::isConnected() const
+{
+    return connected;
+}
+
+bool WiFiTimeManager::waitForConnection(unsigned long timeoutMs)
+{
+    unsigned long start = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - start < timeoutMs)
+    {
+        delay(100);
+    }
+    update();
+    return connected;
+}
+
 void WiFiTimeManager::syncTimeWithNTP()
 {
     const char *ntpServer = "pool.ntp.org";
     configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
 
+    // SNTP keeps retrying in the background, so a failure here only delays the first valid time
     struct tm timeinfo;
     if (!getLocalTime(&timeinfo))
     {
         SERIAL_PRINTLN("Failed to obtain time");
     }
+    synced = true;
     lastSyncTime = millis();
 }
 
-struct tm WiFiTimeManager::getLocalTimeStruct()
+bool WiFiTimeManager::getTime(struct tm &timeinfo)
 {
-    struct tm timeinfo;
-    if (getLocalTime(&timeinfo))
-    {
-        return timeinfo;
-    }
-    else
-    {
-        memset(&timeinfo, 0, sizeof(struct tm));
-        SERIAL_PRINTLN("Failed to obtain local time");
-        return timeinfo;
-    }
+    return getLocalTime(&timeinfo, 0);
+}
+
+bool WiFiTimeManager::getTime(struct tm &timeinfo, uint16_t &milliseconds)
+{
+    // Read separately, the second may tick over in between; callers then just wake a second early
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    milliseconds = now.tv_usec / 1000;
+    return getLocalTime(&timeinfo, 0);
 }
 
 bool WiFiTimeManager::downloadGIF(const char *gifUrl)
@@ -61,8 +97,11 @@ bool WiFiTimeManager::downloadGIF(const char *gifUrl)
     if (WiFi.status() == WL_CONNECTED)
     {
         HTTPClient http;
+        const char *headerKeys[] = {"Transfer-Encoding"};
+        http.collectHeaders(headerKeys, 1);
         http.begin(gifUrl);
 
+        unsigned long requestStart = millis();
         int httpResponseCode = http.GET();
         if (httpResponseCode == HTTP_CODE_OK)
         {
@@ -75,10 +114,22 @@ bool WiFiTimeManager::downloadGIF(const char *gifUrl)
                 return false;
             }
 
-            gifBuffer = handleDownloadGIFResponse(http, gifSize);
-            gifBufferSize = gifSize;
+            if (gifBuffer == nullptr)
+            {
+                gifBuffer = (uint8_t *)malloc(MAX_GIF_SIZE);
+                if (gifBuffer == nullptr)
+                {
+                    SERIAL_PRINTLN("Memory allocation failed for GIF");
+                    http.end();
+                    return false;
+                }
+            }
+
+            bool chunked = http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+            int bytesRead = handleDownloadGIFResponse(http, gifSize, chunked, requestStart);
+            gifBufferSize = bytesRead > 0 ? bytesRead : 0;
             http.end();
-            return gifBuffer != nullptr;
+            return gifBufferSize > 0;
         }
         else
         {
@@ -94,36 +145,153 @@ bool WiFiTimeManager::downloadGIF(const char *gifUrl)
     }
 }
 
-uint8_t *WiFiTimeManager::handleDownloadGIFResponse(HTTPClient &http, int gifSize)
+int WiFiTimeManager::handleDownloadGIFResponse(HTTPClient &http, int gifSize, bool chunked, unsigned long requestStart)
 {
-    WiFiClient *stream = http.getStreamPtr();
+    if (gifSize == 0)
+    {
+        SERIAL_PRINTLN("No data available for GIF");
+        return -1;
+    }
+
+    SERIAL_PRINTLN("Downloading GIF...");
 
-    if (gifSize > 0)
+    unsigned long lastData = millis();
+    int bytesRead = 0;
+    lastDownload = {};
+    lastDownload.chunked = chunked;
+
+    WiFiClient *stream = http.getStreamPtr();
+    while (stream->available() <= 0)
     {
-        SERIAL_PRINTLN("Downloading GIF...");
+        if (millis() - lastData > DOWNLOAD_TIMEOUT_MS)
+        {
+            SERIAL_PRINTLN("GIF download timed out");
+            return -1;
+        }
+        delay(1);
+    }
+    lastDownload.timeToFirstByteMs = millis() - requestStart;
 
-        uint8_t *buffer = (uint8_t *)malloc(gifSize);
-        if (buffer == nullptr)
+    if (chunked)
+    {
+        // Each chunk is "<hex size>\r\n<data>\r\n", terminated by a zero-size chunk
+        char line[16];
+        while (true)
         {
-            SERIAL_PRINTLN("Memory allocation failed for GIF");
-            return nullptr;
+            if (!readLine(http, line, sizeof(line), lastData))
+            {
+                SERIAL_PRINTLN("GIF download timed out");
+                return -1;
+            }
+            int chunkSize = strtol(line, nullptr, 16);
+            if (chunkSize == 0)
+            {
+                break;
+            }
+            if (bytesRead + chunkSize > MAX_GIF_SIZE)
+            {
+                SERIAL_PRINTLN("GIF is too large. Max size allowed is 32KB.");
+                return -1;
+            }
+            if (readBody(http, gifBuffer + bytesRead, chunkSize, false, lastData) != chunkSize)
+            {
+                SERIAL_PRINTLN("GIF download timed out");
+                return -1;
+            }
+            bytesRead += chunkSize;
+            readLine(http, line, sizeof(line), lastData);
         }
+    }
+    else
+    {
+        // Without a Content-Length the body ends when the server closes the connection
+        bool untilClosed = gifSize < 0;
+        int length = untilClosed ? MAX_GIF_SIZE : gifSize;
+        bytesRead = readBody(http, gifBuffer, length, untilClosed, lastData);
+        if (!untilClosed && bytesRead != gifSize)
+        {
+            SERIAL_PRINTLN("GIF download timed out");
+            return -1;
+        }
+        // A full buffer only holds the whole body if the server closes right after it
+        uint8_t extra;
+        if (untilClosed && bytesRead == MAX_GIF_SIZE &&
+            (readBody(http, &extra, 1, true, lastData) > 0 || http.connected()))
+        {
+            SERIAL_PRINTLN("GIF is too large. Max size allowed is 32KB.");
+            return -1;
+        }
+    }
 
-        int bytesRead = 0;
-        while (http.connected() && stream->available() > 0 && bytesRead < gifSize)
+    lastDownload.bytes = bytesRead;
+    lastDownload.totalMs = millis() - requestStart;
+    lastDownload.bytesPerSecond = lastDownload.totalMs > 0 ? (uint64_t)bytesRead * 1000 / lastDownload.totalMs : bytesRead;
+
+    SERIAL_PRINT("GIF downloaded and stored in memory: ");
+    SERIAL_PRINT(bytesRead);
+    SERIAL_PRINT(" bytes, first byte after ");
+    SERIAL_PRINT(lastDownload.timeToFirstByteMs);
+    SERIAL_PRINT(" ms, ");
+    SERIAL_PRINT(lastDownload.bytesPerSecond);
+    SERIAL_PRINTLN(" B/s");
+    return bytesRead;
+}
+
+int WiFiTimeManager::readBody(HTTPClient &http, uint8_t *dest, int length, bool untilClosed, unsigned long &lastData)
+{
+    WiFiClient *stream = http.getStreamPtr();
+    int bytesRead = 0;
+
+    // A momentarily empty socket is not the end of the body; wait for more until the timeout
+    while (bytesRead < length)
+    {
+        int available = stream->available();
+        if (available <= 0)
         {
-            int byte = stream->read();
-            buffer[bytesRead++] = byte;
+            if ((untilClosed && !http.connected()) || millis() - lastData > DOWNLOAD_TIMEOUT_MS)
+            {
+                break;
+            }
+            delay(1);
+            continue;
         }
 
-        SERIAL_PRINTLN("GIF downloaded and stored in memory");
-        return buffer;
+        int chunk = available < length - bytesRead ? available : length - bytesRead;
+        int count = stream->read(dest + bytesRead, chunk);
+        if (count > 0)
+        {
+            bytesRead += count;
+            lastData = millis();
+        }
     }
-    else
+    return bytesRead;
+}
+
+bool WiFiTimeManager::readLine(HTTPClient &http, char *line, size_t size, unsigned long &lastData)
+{
+    WiFiClient *stream = http.getStreamPtr();
+    size_t length = 0;
+
+    while (millis() - lastData <= DOWNLOAD_TIMEOUT_MS)
     {
-        SERIAL_PRINTLN("No data available for GIF");
-        return nullptr;
+        int c = stream->read();
+        if (c < 0)
+        {
+            delay(1);
+            continue;
+        }
+        lastData = millis();
+        if (c == '\n')
+        {
+            line[length] = '\0';
+            return true;
+        }
+        if (c != '\r' && length < size - 1)
+        {
+            line[length++] = c;
+        }
     }
+    return false;
 }
 
 uint8_t *WiFiTimeManager::getGifBuffer()
@@ -135,3 +303,8 @@ size_t WiFiTimeManager::getGifBufferSize()
 {
     return gifBufferSize;
 }
+
+const DownloadStats &WiFiTimeManager::getLastDownloadStats() const
+{
+    return lastDownload;
+}
@@ -3,18 +3,37 @@
 
 #include <WiFi.h>
 #include <time.h>
+#include <sys/time.h>
 #include <HTTPClient.h>
 
+struct DownloadStats
+{
+    size_t bytes;
+    unsigned long timeToFirstByteMs;
+    unsigned long totalMs;
+    uint32_t bytesPerSecond;
+    bool chunked;
+};
+
 class WiFiTimeManager
 {
 public:
     WiFiTimeManager(char *ssid, char *password, long gmtOffset_sec, int daylightOffset_sec);
+    // Starts connecting and returns straight away; update() finishes the job
     void setup();
+    // Reconnects after drops and resyncs NTP; may block, so run it off the render task
     void update();
-    struct tm getLocalTimeStruct();
+    bool isConnected() const;
+    // Only for boot-time tools that need the network before the clock starts
+    bool waitForConnection(unsigned long timeoutMs);
+    // False until the RTC has been set; never blocks
+    bool getTime(struct tm &timeinfo);
+    // Also reports how far into the current second the RTC is
+    bool getTime(struct tm &timeinfo, uint16_t &milliseconds);
     bool downloadGIF(const char *gifUrl);
     uint8_t *getGifBuffer();
     size_t getGifBufferSize();
+    const DownloadStats &getLastDownloadStats() const;
 
 private:
     char *ssid;
@@ -23,11 +42,19 @@ private:
     int daylightOffset_sec;
     unsigned long lastSyncTime;
     const unsigned long syncInterval = 86400000;
+    unsigned long lastReconnectAttempt;
+    const unsigned long reconnectInterval = 10000;
+    bool connected;
+    bool synced;
+    // Allocated once on first download and reused afterwards
     uint8_t *gifBuffer = nullptr;
     size_t gifBufferSize = 0;
+    DownloadStats lastDownload = {};
 
     void syncTimeWithNTP();
-    uint8_t *handleDownloadGIFResponse(HTTPClient &http, int gifSize);
+    int handleDownloadGIFResponse(HTTPClient &http, int gifSize, bool chunked, unsigned long requestStart);
+    int readBody(HTTPClient &http, uint8_t *dest, int length, bool untilClosed, unsigned long &lastData);
+    bool readLine(HTTPClient &http, char *line, size_t size, unsigned long &lastData);
 };
 
 #endif
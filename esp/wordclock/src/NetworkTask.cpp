@@ -0,0 +1,117 @@
+#include "NetworkTask.h"
+#include "SerialHelper.h"
+
+NetworkTask::NetworkTask(WiFiTimeManager *networkManager, GifCache *gifCache, FrameScheduler *scheduler)
+    : networkManager(networkManager), gifCache(gifCache), scheduler(scheduler), timeValid(false)
+{
+}
+
+void NetworkTask::begin()
+{
+#ifndef __LINUX__
+    // Same priority as the Arduino loop task, so they share the core by time slicing
+    if (xTaskCreate(run, "network", STACK_SIZE, this, 1, &handle) != pdPASS)
+    {
+        SERIAL_PRINTLN("Failed to start network task");
+    }
+#endif
+}
+
+void NetworkTask::poll()
+{
+#ifdef __LINUX__
+    step();
+#endif
+}
+
+#ifndef __LINUX__
+void NetworkTask::run(void *arg)
+{
+    NetworkTask *self = static_cast<NetworkTask *>(arg);
+    while (true)
+    {
+        self->step();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_MS));
+    }
+}
+#endif
+
+void NetworkTask::step()
+{
+    networkManager->update();
+
+    struct tm timeinfo;
+    if (!timeValid && networkManager->getTime(timeinfo))
+    {
+        timeValid = true;
+        post({NetworkEvent::TIME_SYNCED, nullptr, {}, nullptr, 0});
+    }
+
+    NetworkRequest request;
+    while (requests.pop(request))
+    {
+        if (request.type == NetworkRequest::FETCH_GIF)
+        {
+            fetchGIF(request.url);
+        }
+    }
+}
+
+void NetworkTask::fetchGIF(const char *url)
+{
+    NetworkEvent event = {NetworkEvent::GIF_READY, url, {}, nullptr, 0};
+
+    // Flash first: works offline and skips the download when the copy is fresh
+    const char *cachedPath = gifCache != nullptr ? gifCache->fetch(url) : nullptr;
+    if (cachedPath != nullptr)
+    {
+        strncpy(event.path, cachedPath, sizeof(event.path) - 1);
+        post(event);
+        return;
+    }
+
+    // Without a usable cache, keep the whole GIF in RAM instead
+    if (networkManager->downloadGIF(url))
+    {
+        event.buffer = networkManager->getGifBuffer();
+        event.size = networkManager->getGifBufferSize();
+        post(event);
+        return;
+    }
+
+    event.type = NetworkEvent::GIF_FAILED;
+    post(event);
+}
+
+void NetworkTask::post(const NetworkEvent &event)
+{
+    if (!events.push(event))
+    {
+        SERIAL_PRINTLN("Network event queue full, dropping event");
+        return;
+    }
+    scheduler->wake();
+}
+
+bool NetworkTask::request(const NetworkRequest &request)
+{
+    if (!requests.push(request))
+    {
+        return false;
+    }
+#ifdef __LINUX__
+    // poll() runs on the render loop here, so keep it from sleeping past the request
+    scheduler->wake();
+#else
+    if (handle != nullptr)
+    {
+        xTaskNotifyGive(handle);
+    }
+#endif
+    return true;
+}
+
+bool NetworkTask::nextEvent(NetworkEvent &event)
+{
+    return events.pop(event);
+}
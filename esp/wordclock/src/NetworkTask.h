@@ -0,0 +1,79 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+#include "NetworkManager.h"
+#include "GifCache.h"
+#include "SpscQueue.h"
+#include "FrameScheduler.h"
+
+struct NetworkRequest
+{
+    enum Type : uint8_t
+    {
+        FETCH_GIF
+    };
+
+    Type type;
+    const char *url; // must outlive the request, e.g. an entry of GIF_URLS
+};
+
+struct NetworkEvent
+{
+    enum Type : uint8_t
+    {
+        TIME_SYNCED,
+        GIF_READY,
+        GIF_FAILED
+    };
+
+    Type type;
+    const char *url;
+    // GIF_READY: a cached file, or else a GIF held in WiFiTimeManager's buffer
+    char path[32];
+    uint8_t *buffer;
+    size_t size;
+};
+
+// Runs WiFi reconnects, NTP and GIF downloads on their own FreeRTOS task so a
+// slow network never stalls rendering. The render task talks to it only
+// through two SPSC queues: requests in, events out.
+//
+// The download buffer named by a GIF_READY event belongs to the render task
+// until it sends its next FETCH_GIF request.
+class NetworkTask
+{
+public:
+    // Events wake the scheduler so the render task picks them up without polling
+    NetworkTask(WiFiTimeManager *networkManager, GifCache *gifCache, FrameScheduler *scheduler);
+    void begin();
+    // On the host simulator there are no threads, so this runs one iteration inline; a no-op on the ESP32
+    void poll();
+
+    // Render task side
+    bool request(const NetworkRequest &request);
+    bool nextEvent(NetworkEvent &event);
+
+private:
+    static const uint32_t QUEUE_SIZE = 4;
+    static const uint32_t STACK_SIZE = 8192;
+    // Longest wait between steps when no request arrives; paces reconnects and NTP checks
+    static const unsigned long IDLE_MS = 1000;
+
+    WiFiTimeManager *networkManager;
+    GifCache *gifCache;
+    FrameScheduler *scheduler;
+    SpscQueue<NetworkRequest, QUEUE_SIZE> requests;
+    SpscQueue<NetworkEvent, QUEUE_SIZE> events;
+    bool timeValid;
+
+    void step();
+    void fetchGIF(const char *url);
+    void post(const NetworkEvent &event);
+#ifndef __LINUX__
+    TaskHandle_t handle = nullptr;
+    static void run(void *arg);
+#endif
+};
+
+#endif
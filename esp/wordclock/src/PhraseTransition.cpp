@@ -0,0 +1,120 @@
+#include "PhraseTransition.h"
+#include "FixedMath.h"
+
+// Width of the soft edge, in 256ths of the transition
+static const uint16_t WIPE_EDGE = 2 * 256 / ClockDisplayHAL::WIDTH;
+static const uint16_t DISSOLVE_FADE = 48;
+
+// Clamps (position - start) / width into 0..255
+static uint8_t ramp(int32_t position, int32_t start, int32_t width)
+{
+    int32_t value = (position - start) * 255 / width;
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+PhraseTransition::PhraseTransition(ClockDisplayHAL *hal)
+    : hal(hal), type(TransitionType::CUT), startTime(0), durationMs(0), nextFrameTime(0), running(false), toMask{}, from{}, to{}
+{
+}
+
+void PhraseTransition::begin(TransitionType newType, const LedMask &mask, const uint8_t *rgb, unsigned long newDurationMs)
+{
+    if (newType == TransitionType::RANDOM)
+    {
+        newType = static_cast<TransitionType>(random(static_cast<long>(TransitionType::CROSSFADE), static_cast<long>(TransitionType::RANDOM)));
+    }
+
+    // Start from whatever the text layer shows, so an interrupted transition continues smoothly
+    const uint8_t *current = hal->layerPixels(Layer::TEXT);
+    const LedMask &currentMask = hal->layerMask(Layer::TEXT);
+    for (uint8_t i = 0; i < ClockDisplayHAL::NUM_LEDS; ++i)
+    {
+        bool lit = currentMask.test(i);
+        bool next = mask.test(i);
+        for (uint8_t c = 0; c < 3; ++c)
+        {
+            from[i * 3 + c] = lit ? current[i * 3 + c] : 0;
+            to[i * 3 + c] = next ? rgb[i * 3 + c] : 0;
+        }
+    }
+
+    type = newType;
+    toMask = mask;
+    hal->layerMask(Layer::TEXT) = currentMask | mask;
+    durationMs = newDurationMs;
+    startTime = millis();
+    nextFrameTime = startTime;
+    running = true;
+}
+
+void PhraseTransition::tick(unsigned long now)
+{
+    if (!running || (long)(now - nextFrameTime) < 0)
+    {
+        return;
+    }
+
+    unsigned long elapsed = now - startTime;
+    if (type == TransitionType::CUT || elapsed >= durationMs)
+    {
+        render(255);
+        hal->layerMask(Layer::TEXT) = toMask;
+        // The finished phrase stays up with no frames after it to even out dithering
+        hal->showStill();
+        running = false;
+        return;
+    }
+
+    render(elapsed * 255 / durationMs);
+    hal->show();
+    nextFrameTime += FRAME_MS;
+    if ((long)(now - nextFrameTime) >= 0)
+    {
+        nextFrameTime = now + FRAME_MS;
+    }
+}
+
+uint8_t PhraseTransition::progress(uint8_t led, uint8_t t) const
+{
+    switch (type)
+    {
+    case TransitionType::WIPE:
+    {
+        // Left to right with a soft edge two columns wide
+        int32_t column = LED_TO_GRID.coord[led].x * 256 / ClockDisplayHAL::WIDTH;
+        return ramp(t * (256 + WIPE_EDGE) / 255, column, WIPE_EDGE);
+    }
+    case TransitionType::DISSOLVE:
+    {
+        // Every LED fades on its own turn; 167 is odd, so the turns are distinct
+        uint8_t turn = (uint8_t)(led * 167);
+        return ramp(t * (256 + DISSOLVE_FADE) / 255, turn, DISSOLVE_FADE);
+    }
+    default:
+        return t;
+    }
+}
+
+void PhraseTransition::render(uint8_t t)
+{
+    uint8_t *text = hal->layerPixels(Layer::TEXT);
+    for (uint8_t i = 0; i < ClockDisplayHAL::NUM_LEDS; ++i)
+    {
+        uint8_t p = progress(i, t);
+        for (uint8_t c = 0; c < 3; ++c)
+        {
+            text[i * 3 + c] = blend8(from[i * 3 + c], to[i * 3 + c], p);
+        }
+    }
+    hal->composite();
+}
+
+bool PhraseTransition::done() const
+{
+    return !running;
+}
+
+unsigned long PhraseTransition::nextDeadline() const
+{
+    return nextFrameTime;
+}
@@ -0,0 +1,52 @@
+#ifndef PHRASE_TRANSITION_H
+#define PHRASE_TRANSITION_H
+
+#include <Arduino.h>
+#include "Animation.h"
+#include "ClockDisplayHAL.h"
+
+enum class TransitionType
+{
+    CUT,
+    CROSSFADE,
+    WIPE,
+    DISSOLVE,
+    RANDOM
+};
+
+// Animates the HAL's text layer from the words it shows now to a new set.
+// Each frame gives every LED a progress from 0 (old colour) to 255 (new
+// colour), blends the two, and composites the layers to the strip.
+class PhraseTransition : public Animation
+{
+public:
+    // ~60 FPS
+    static const unsigned long FRAME_MS = 16;
+
+    PhraseTransition(ClockDisplayHAL *hal);
+
+    // rgb is RGB888 in strip order; LEDs outside mask end up off
+    void begin(TransitionType type, const LedMask &mask, const uint8_t *rgb, unsigned long durationMs);
+
+    void tick(unsigned long now) override;
+    bool done() const override;
+    unsigned long nextDeadline() const override;
+
+private:
+    ClockDisplayHAL *hal;
+    TransitionType type;
+    unsigned long startTime;
+    unsigned long durationMs;
+    unsigned long nextFrameTime;
+    bool running;
+
+    LedMask toMask;
+    uint8_t from[ClockDisplayHAL::NUM_LEDS * 3];
+    uint8_t to[ClockDisplayHAL::NUM_LEDS * 3];
+
+    // Blends and composites the text layer; the caller pushes it
+    void render(uint8_t t);
+    uint8_t progress(uint8_t led, uint8_t t) const;
+};
+
+#endif
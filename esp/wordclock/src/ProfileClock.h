@@ -0,0 +1,43 @@
+#ifndef PROFILE_CLOCK_H
+#define PROFILE_CLOCK_H
+
+#include <Arduino.h>
+
+// High-resolution timestamps for profiling short intervals. On the ESP32 this
+// is the CPU cycle counter (wraps every ~27 s at 160 MHz); on the host it is
+// the steady clock in nanoseconds.
+#ifdef __LINUX__
+#include <chrono>
+
+inline uint32_t profileTicks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint32_t profileTicksToNs(uint32_t ticks)
+{
+    return ticks;
+}
+
+inline uint32_t profileCpuMHz()
+{
+    return 0;
+}
+#else
+inline uint32_t profileTicks()
+{
+    return ESP.getCycleCount();
+}
+
+inline uint32_t profileTicksToNs(uint32_t ticks)
+{
+    return (uint64_t)ticks * 1000 / ESP.getCpuFreqMHz();
+}
+
+inline uint32_t profileCpuMHz()
+{
+    return ESP.getCpuFreqMHz();
+}
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+#include "RmtLedOutput.h"
+
+#ifndef __LINUX__
+#include <esp_arduino_version.h>
+#if ESP_ARDUINO_VERSION_MAJOR < 3
+#include <driver/rmt.h>
+#include <soc/soc.h>
+#define RMT_LED_CHANNEL RMT_CHANNEL_0
+#endif
+#endif
+
+// 100 ns RMT ticks. An item is one bit: high for duration0, then low for duration1.
+#define RMT_TICK_HZ 10000000
+#define ITEM(high, low) ((uint32_t)(high) | (1UL << 15) | ((uint32_t)(low) << 16))
+static const uint32_t WS2812_BIT_0 = ITEM(4, 9); // 0.4 us high, 0.85 us low
+static const uint32_t WS2812_BIT_1 = ITEM(8, 5); // 0.8 us high, 0.45 us low
+static const uint32_t WS2812_US_PER_LED = 30;    // 24 bits of 1.25 us
+static const uint32_t WS2812_LATCH_US = 300;     // low time that ends a frame
+
+RmtLedOutput::RmtLedOutput(uint8_t pin, uint16_t numLeds)
+    : pin(pin), numLeds(numLeds), buffers{nullptr, nullptr}, back(0), ready(false), inFlight(false), lastStartUs(0)
+{
+}
+
+RmtLedOutput::~RmtLedOutput()
+{
+    free(buffers[0]);
+    free(buffers[1]);
+}
+
+bool RmtLedOutput::begin()
+{
+#ifdef __LINUX__
+    return false;
+#else
+    size_t bytes = numLeds * 24 * sizeof(uint32_t);
+    buffers[0] = (uint32_t *)malloc(bytes);
+    buffers[1] = (uint32_t *)malloc(bytes);
+    if (buffers[0] == nullptr || buffers[1] == nullptr)
+    {
+        return false;
+    }
+
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    ready = rmtInit(pin, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, RMT_TICK_HZ);
+#else
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, RMT_LED_CHANNEL);
+    config.clk_div = APB_CLK_FREQ / RMT_TICK_HZ;
+    ready = rmt_config(&config) == ESP_OK && rmt_driver_install(RMT_LED_CHANNEL, 0, 0) == ESP_OK;
+#endif
+    return ready;
+#endif
+}
+
+bool RmtLedOutput::isReady() const
+{
+    return ready;
+}
+
+void RmtLedOutput::encode(const uint8_t *grb, uint32_t *items)
+{
+    for (uint16_t i = 0; i < numLeds * 3; ++i)
+    {
+        uint8_t byte = grb[i];
+        for (uint8_t bit = 0; bit < 8; ++bit, byte <<= 1)
+        {
+            *items++ = (byte & 0x80) ? WS2812_BIT_1 : WS2812_BIT_0;
+        }
+    }
+}
+
+void RmtLedOutput::write(const uint8_t *grb)
+{
+    if (!ready)
+    {
+        return;
+    }
+
+    // Encoding into the back buffer overlaps the transfer still using the front one
+    encode(grb, buffers[back]);
+
+    waitForCompletion();
+    unsigned long sinceStart = micros() - lastStartUs;
+    unsigned long frameUs = numLeds * WS2812_US_PER_LED + WS2812_LATCH_US;
+    if (sinceStart < frameUs)
+    {
+        delayMicroseconds(frameUs - sinceStart);
+    }
+
+#ifndef __LINUX__
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    rmtWriteAsync(pin, (rmt_data_t *)buffers[back], numLeds * 24);
+#else
+    rmt_write_items(RMT_LED_CHANNEL, (const rmt_item32_t *)buffers[back], numLeds * 24, false);
+#endif
+#endif
+    lastStartUs = micros();
+    inFlight = true;
+    back ^= 1;
+}
+
+bool RmtLedOutput::isComplete()
+{
+    if (!inFlight)
+    {
+        return true;
+    }
+#ifndef __LINUX__
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    inFlight = !rmtTransmitCompleted(pin);
+#else
+    inFlight = rmt_wait_tx_done(RMT_LED_CHANNEL, 0) != ESP_OK;
+#endif
+#endif
+    return !inFlight;
+}
+
+void RmtLedOutput::waitForCompletion()
+{
+    while (!isComplete())
+    {
+        yield();
+    }
+}
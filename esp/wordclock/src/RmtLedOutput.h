@@ -0,0 +1,39 @@
+#ifndef RMT_LED_OUTPUT_H
+#define RMT_LED_OUTPUT_H
+
+#include <Arduino.h>
+
+// WS2812 output on the ESP32's RMT peripheral. write() encodes a frame into one
+// of two RMT item buffers and starts the transfer without waiting for it, so
+// the next frame is rendered while this one is still being clocked out; the
+// other buffer is only reused once the fence says that transfer is over.
+class RmtLedOutput
+{
+public:
+    RmtLedOutput(uint8_t pin, uint16_t numLeds);
+    ~RmtLedOutput();
+
+    // False when there is no RMT peripheral (host builds) or allocation fails
+    bool begin();
+    bool isReady() const;
+
+    // Starts sending numLeds pixels of GRB bytes; waits for the previous frame first if needed
+    void write(const uint8_t *grb);
+
+    // Fence for the last write()
+    bool isComplete();
+    void waitForCompletion();
+
+private:
+    uint8_t pin;
+    uint16_t numLeds;
+    uint32_t *buffers[2];
+    uint8_t back;
+    bool ready;
+    bool inFlight;
+    unsigned long lastStartUs;
+
+    void encode(const uint8_t *grb, uint32_t *items);
+};
+
+#endif
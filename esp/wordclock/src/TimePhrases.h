@@ -0,0 +1,93 @@
+#ifndef TIME_PHRASES_H
+#define TIME_PHRASES_H
+
+#include "WordLayout.h"
+
+// Every 5-minute slot of a 12-hour day resolved to its words and LED mask at
+// compile time from the layout's LAYOUT_PHRASES, so displaying the time is a
+// single table lookup.
+
+struct TimePhrase
+{
+    // Room for the minute dots exactTimePhrase() adds
+    static constexpr uint8_t MAX_WORDS = LAYOUT_PHRASE_MAX_WORDS + LAYOUT_MINUTE_DOT_COUNT;
+
+    LedMask mask;
+    WordId words[MAX_WORDS];
+    uint8_t wordCount;
+};
+
+constexpr uint8_t PHRASE_SLOTS_PER_HOUR = 12;
+constexpr uint8_t PHRASE_COUNT = 12 * PHRASE_SLOTS_PER_HOUR;
+
+static_assert(LAYOUT_PHRASE_COUNT == PHRASE_COUNT, "the layout must give the words of every 5-minute slot");
+static_assert(LAYOUT_MINUTE_DOT_COUNT == 4, "one minute dot for each minute past a slot");
+
+constexpr TimePhrase buildTimePhrase(const LayoutPhrase &source)
+{
+    TimePhrase phrase{};
+    for (uint8_t i = 0; i < source.wordCount; ++i)
+    {
+        phrase.words[phrase.wordCount++] = source.words[i];
+    }
+    phrase.mask = phraseMask(phrase.words, phrase.wordCount);
+    return phrase;
+}
+
+struct TimePhraseTable
+{
+    TimePhrase phrases[PHRASE_COUNT];
+};
+
+constexpr TimePhraseTable buildTimePhraseTable()
+{
+    TimePhraseTable table{};
+    for (uint8_t i = 0; i < PHRASE_COUNT; ++i)
+    {
+        table.phrases[i] = buildTimePhrase(LAYOUT_PHRASES[i]);
+    }
+    return table;
+}
+
+inline constexpr TimePhraseTable TIME_PHRASES = buildTimePhraseTable();
+
+constexpr uint8_t phraseIndex(int hour, int minute)
+{
+    return (hour % 12) * PHRASE_SLOTS_PER_HOUR + minute / 5;
+}
+
+constexpr const TimePhrase &timePhrase(uint8_t index)
+{
+    return TIME_PHRASES.phrases[index];
+}
+
+// Minutes past the 5-minute slot, 0-4
+constexpr uint8_t minuteDots(int minute)
+{
+    return minute % 5;
+}
+
+// The slot's phrase followed by the first `dots` minute dots
+constexpr TimePhrase exactTimePhrase(uint8_t index, uint8_t dots)
+{
+    TimePhrase phrase = timePhrase(index);
+    for (uint8_t i = 0; i < dots; ++i)
+    {
+        phrase.words[phrase.wordCount++] = LAYOUT_MINUTE_DOTS[i];
+        phrase.mask |= wordMask(LAYOUT_MINUTE_DOTS[i]);
+    }
+    return phrase;
+}
+
+#ifdef WORD_LAYOUT_ENGLISH
+static_assert(timePhrase(phraseIndex(0, 0)).mask == (wordMask(WordId::IT) | wordMask(WordId::IS) | wordMask(WordId::OCLOCK) | wordMask(WordId::HOUR_12)),
+              "00:00 is IT IS TWELVE OCLOCK");
+static_assert(timePhrase(phraseIndex(15, 25)).mask == (wordMask(WordId::IT) | wordMask(WordId::IS) | wordMask(WordId::TWENTYFIVE) | wordMask(WordId::MINUTES) | wordMask(WordId::PAST) | wordMask(WordId::HOUR_3)),
+              "15:25 is IT IS TWENTYFIVE MINUTES PAST THREE");
+static_assert(timePhrase(phraseIndex(23, 45)).mask == (wordMask(WordId::IT) | wordMask(WordId::IS) | wordMask(WordId::FIFTEEN) | wordMask(WordId::MINUTES) | wordMask(WordId::TO) | wordMask(WordId::HOUR_12)),
+              "23:45 is IT IS FIFTEEN MINUTES TO TWELVE");
+static_assert(exactTimePhrase(phraseIndex(15, 27), minuteDots(27)).mask == (timePhrase(phraseIndex(15, 25)).mask | wordMask(WordId::DOT_1) | wordMask(WordId::DOT_2)),
+              "15:27 is 15:25 and two dots");
+#endif
+
+#endif
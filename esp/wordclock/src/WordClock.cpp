@@ -18,80 +18,229 @@ const char *GIF_URLS[] = {
     "https://raw.githubusercontent.com/markgwharry/word-clock/main/esp/wordclock/gifs/rainbow.gif",
     "https://raw.githubusercontent.com/markgwharry/word-clock/main/esp/wordclock/gifs/fireworks.gif",
     "https://raw.githubusercontent.com/markgwharry/word-clock/main/esp/wordclock/gifs/sun.gif"};
-const int NUM_GIFS = 6;
+const int NUM_GIFS = sizeof(GIF_URLS) / sizeof(GIF_URLS[0]);
 
-WordClock::WordClock(ClockDisplayHAL *clockDisplayHAL, WiFiTimeManager *networkManager, GifPlayer *gifPlayer, DisplayEffects *displayEffects)
-    : clockDisplayHAL(clockDisplayHAL), networkManager(networkManager), gifPlayer(gifPlayer), displayEffects(displayEffects), lastHour(-1), allLastHighlightedWords("") {}
+WordClock::WordClock(ClockDisplayHAL *clockDisplayHAL, WiFiTimeManager *networkManager, NetworkTask *networkTask, GifPlayer *gifPlayer, ClipPlayer *clipPlayer, DisplayEffects *displayEffects, PhraseTransition *phraseTransition, FrameScheduler *scheduler, bool minutePrecision)
+    : lastHour(-1), lastPhraseIndex(-1), lastMinuteDots(0), minutePrecision(minutePrecision), clockDisplayHAL(clockDisplayHAL), networkManager(networkManager), networkTask(networkTask), gifPlayer(gifPlayer), clipPlayer(clipPlayer), displayEffects(displayEffects), phraseTransition(phraseTransition), scheduler(scheduler), pendingGif(nullptr), pendingSince(0), pendingPrefetch(false), prefetchHour(-1), prefetched(nullptr), prefetchedAt(0), lastPrefetchAttempt(0), prefetchStats{}, phraseRgb{} {}
 
 void WordClock::setup()
 {
-    downloadAndPlayRandomGIF();
+    requestRandomGIF(false);
 }
 
-void WordClock::downloadAndPlayRandomGIF()
+bool WordClock::requestRandomGIF(bool prefetch)
 {
+    if (pendingGif != nullptr)
+    {
+        return false;
+    }
+
     int gifIndex = random(0, NUM_GIFS);
     const char *gifUrl = GIF_URLS[gifIndex];
+    if (!networkTask->request({NetworkRequest::FETCH_GIF, gifUrl}))
+    {
+        SERIAL_PRINTLN("Network task busy, skipping GIF");
+        return false;
+    }
+    pendingGif = gifUrl;
+    pendingSince = millis();
+    pendingPrefetch = prefetch;
+    return true;
+}
 
-    SERIAL_PRINT("Downloading GIF: ");
-    SERIAL_PRINTLN(gifUrl);
-
-    if (networkManager->downloadGIF(gifUrl))
+bool WordClock::handleNetworkEvents(unsigned long now)
+{
+    bool started = false;
+    NetworkEvent event;
+    while (networkTask->nextEvent(event))
     {
-        uint8_t *gifBuffer = networkManager->getGifBuffer();
-        size_t gifSize = networkManager->getGifBufferSize();
-        if (gifSize > 0 && gifBuffer != nullptr)
+        if (event.type == NetworkEvent::TIME_SYNCED)
         {
-            if (gifPlayer->loadGIF(gifBuffer, gifSize))
+            SERIAL_PRINTLN("Time is valid");
+            lastPhraseIndex = -1;
+        }
+        else if (event.url == pendingGif)
+        {
+            pendingGif = nullptr;
+            if (pendingPrefetch)
+            {
+                preparePrefetch(event);
+            }
+            else if (now - pendingSince > GIF_MAX_WAIT_MS)
+            {
+                SERIAL_PRINTLN("GIF arrived too late, skipping");
+                continue;
+            }
+            else
             {
-                SERIAL_PRINTLN("GIF downloaded and loaded successfully.");
-                gifPlayer->playGIF(4000);
-                clockDisplayHAL->clearPixels(false);
+                SERIAL_PRINT("Playing GIF: ");
+                SERIAL_PRINTLN(event.url);
+                started = startGIF(event.type == NetworkEvent::GIF_READY ? loadGIF(event) : nullptr);
             }
         }
     }
-    else
+    return started;
+}
+
+void WordClock::schedulePrefetch(int hour, int minute)
+{
+    // A prefetch is good from its lead time until the top of its hour. One whose
+    // hour went by unplayed, e.g. because minute 0 was missed, is dropped so it
+    // doesn't block the next prefetch.
+    bool leadIn = minute >= 60 - PREFETCH_LEAD_MINUTES && hour == (prefetchHour + 11) % 12;
+    bool onTheHour = minute == 0 && hour == prefetchHour;
+    if (prefetchHour >= 0 && !leadIn && !onTheHour)
+    {
+        SERIAL_PRINTLN("GIF prefetch expired unplayed");
+        prefetchHour = -1;
+        prefetched = nullptr;
+    }
+
+    if (minute < 60 - PREFETCH_LEAD_MINUTES || prefetchHour >= 0)
+    {
+        return;
+    }
+    if (lastPrefetchAttempt != 0 && millis() - lastPrefetchAttempt < PREFETCH_RETRY_MS)
+    {
+        return;
+    }
+    if (requestRandomGIF(true))
+    {
+        prefetchHour = (hour + 1) % 12;
+        lastPrefetchAttempt = millis();
+    }
+}
+
+void WordClock::preparePrefetch(const NetworkEvent &event)
+{
+    if (prefetchHour < 0)
+    {
+        // Expired while the download was in flight
+        return;
+    }
+    // Loading validates the GIF and decodes it into the clip ahead of time
+    prefetched = event.type == NetworkEvent::GIF_READY ? loadGIF(event) : nullptr;
+    if (prefetched == nullptr)
+    {
+        SERIAL_PRINTLN("GIF prefetch failed, will retry");
+        prefetchHour = -1;
+        return;
+    }
+    prefetchedAt = millis();
+    SERIAL_PRINT("GIF prefetched: ");
+    SERIAL_PRINTLN(event.url);
+}
+
+bool WordClock::playHourlyGIF(int hour)
+{
+    Animation *animation = prefetchHour == hour ? prefetched : nullptr;
+    prefetchHour = -1;
+    prefetched = nullptr;
+
+    if (animation != nullptr)
     {
-        SERIAL_PRINTLN("Failed to download GIF, using built-in effect instead.");
-        if (displayEffects != nullptr)
+        unsigned long leadMs = millis() - prefetchedAt;
+        prefetchStats.hits++;
+        prefetchStats.lastLeadMs = leadMs;
+        if (prefetchStats.hits == 1 || leadMs < prefetchStats.minLeadMs)
         {
-            displayEffects->playRandomEffect(4000);
-            clockDisplayHAL->clearPixels(false);
+            prefetchStats.minLeadMs = leadMs;
         }
+        SERIAL_PRINT("GIF prefetch hit, ready ");
+        SERIAL_PRINT(leadMs / 1000);
+        SERIAL_PRINT(" s ahead (");
+        SERIAL_PRINT(prefetchStats.hits);
+        SERIAL_PRINT(" hits, ");
+        SERIAL_PRINT(prefetchStats.misses);
+        SERIAL_PRINTLN(" misses)");
+        return startGIF(animation);
+    }
+
+    prefetchStats.misses++;
+    SERIAL_PRINT("GIF prefetch miss (");
+    SERIAL_PRINT(prefetchStats.hits);
+    SERIAL_PRINT(" hits, ");
+    SERIAL_PRINT(prefetchStats.misses);
+    SERIAL_PRINTLN(" misses)");
+
+    // A prefetch still in flight is played as soon as it lands; otherwise fetch one now
+    if (pendingGif != nullptr && pendingPrefetch)
+    {
+        pendingPrefetch = false;
+        pendingSince = millis();
+    }
+    else
+    {
+        requestRandomGIF(false);
     }
+    return false;
 }
 
-void WordClock::highlightWord(const String &word, uint32_t color)
+bool WordClock::startGIF(Animation *animation)
 {
-    clockDisplayHAL->displayWord(word, color);
+    // Repaint the time as soon as the animation ends
+    lastPhraseIndex = -1;
+
+    if ((animation == clipPlayer && clipPlayer->begin(4000)) ||
+        (animation == gifPlayer && gifPlayer->begin(4000)))
+    {
+        scheduler->play(animation);
+        return true;
+    }
+
+    SERIAL_PRINTLN("Failed to load GIF, using built-in effect instead.");
+    if (displayEffects != nullptr)
+    {
+        displayEffects->beginRandom(4000);
+        scheduler->play(displayEffects);
+        return true;
+    }
+    return false;
 }
 
-String WordClock::getMinutesWord(int minute)
+Animation *WordClock::loadGIF(const NetworkEvent &event)
 {
-    if (minute < 5)
-        return "OCLOCK";
-    else if (minute < 10)
-        return "FIVE";
-    else if (minute < 15)
-        return "TEN";
-    else if (minute < 20)
-        return "FIFTEEN";
-    else if (minute < 25)
-        return "TWENTY";
-    else if (minute < 30)
-        return "TWENTYFIVE";
-    else if (minute < 35)
-        return "THIRTY";
-    else if (minute < 40)
-        return "TWENTYFIVE";
-    else if (minute < 45)
-        return "TWENTY";
-    else if (minute < 50)
-        return "FIFTEEN";
-    else if (minute < 55)
-        return "TEN";
+    GifClip &clip = clipPlayer->getClip();
+    bool loaded;
+
+    if (event.path[0] != '\0')
+    {
+        char clipPath[32];
+        GifCache::clipPathFor(event.path, clipPath, sizeof(clipPath));
+        if (clip.load(clipPath))
+        {
+            SERIAL_PRINTLN("GIF clip loaded from cache.");
+            return clipPlayer;
+        }
+
+        loaded = gifPlayer->loadFile(event.path);
+        if (loaded && gifPlayer->decodeToClip(clip))
+        {
+            clip.save(clipPath);
+            SERIAL_PRINTLN("GIF decoded from cache.");
+            return clipPlayer;
+        }
+    }
     else
-        return "FIVE";
+    {
+        loaded = gifPlayer->loadGIF(event.buffer, event.size);
+        if (loaded)
+        {
+            SERIAL_PRINTLN("GIF downloaded and loaded successfully.");
+        }
+    }
+
+    if (!loaded)
+    {
+        return nullptr;
+    }
+    // Decode once up front; GIFs too large for a clip are decoded while they play
+    return gifPlayer->decodeToClip(clip) ? static_cast<Animation *>(clipPlayer) : gifPlayer;
+}
+
+const PrefetchStats &WordClock::getPrefetchStats() const
+{
+    return prefetchStats;
 }
 
 uint32_t WordClock::getRandomColor()
@@ -100,57 +249,85 @@ uint32_t WordClock::getRandomColor()
     return COLORS[index];
 }
 
+void WordClock::update(unsigned long now)
+{
+    // A GIF that just started gets its first tick on the next wake, with a fresh `now`.
+    // Anything else falls through, so displayTime() always sets the next idle deadline.
+    if ((handleNetworkEvents(now) && scheduler->isAnimating()) || scheduler->tick(now))
+    {
+        return;
+    }
+    displayTime();
+}
+
+unsigned long WordClock::msUntilNextWake(const struct tm &currentTime, uint16_t milliseconds) const
+{
+    // The phrase changes every 5 minutes; minute dots and a prefetch waiting for its retry need a look every minute
+    bool retryingPrefetch = currentTime.tm_min >= 60 - PREFETCH_LEAD_MINUTES && prefetchHour < 0;
+    int periodMinutes = minutePrecision || retryingPrefetch ? 1 : 5;
+    long ms = ((periodMinutes - currentTime.tm_min % periodMinutes) * 60L - currentTime.tm_sec) * 1000L - milliseconds;
+    return ms > 0 ? ms : 0;
+}
+
 void WordClock::displayTime()
 {
-    struct tm currentTime = networkManager->getLocalTimeStruct();
+    // Nothing to show until NTP has set the RTC; TIME_SYNCED wakes us then
+    struct tm currentTime;
+    uint16_t milliseconds;
+    if (!networkManager->getTime(currentTime, milliseconds))
+    {
+        return;
+    }
     int hour = currentTime.tm_hour % 12;
-    if (hour == 0)
-        hour = 12;
     int minute = currentTime.tm_min;
 
-    clockDisplayHAL->clearPixels(false);
-
     // Play random GIF on the hour
     if (hour != lastHour && minute == 0)
     {
         lastHour = hour;
-        downloadAndPlayRandomGIF();
+        if (playHourlyGIF(hour))
+        {
+            return;
+        }
     }
+    schedulePrefetch(hour, minute);
+    scheduler->setIdleDeadline(millis() + msUntilNextWake(currentTime, milliseconds));
 
-    highlightWord("IT", getRandomColor());
-    highlightWord("IS", getRandomColor());
-    String allHighlightedWords = "ITIS";
-
-    if (minute < 5)
+    int index = phraseIndex(hour, minute);
+    uint8_t dots = minutePrecision ? minuteDots(minute) : 0;
+    bool newPhrase = index != lastPhraseIndex;
+    if (!newPhrase && dots == lastMinuteDots)
     {
-        highlightWord("OCLOCK", getRandomColor());
-        allHighlightedWords += "OCLOCK";
+        return;
     }
-    else if (minute < 35)
+
+    // Each word in its own color, later words win on shared LEDs; the minute dots are white.
+    // When only the minute changed, just the dots are painted over the current colors.
+    const TimePhrase phrase = exactTimePhrase(index, dots);
+    uint8_t slotWords = timePhrase(index).wordCount;
+    if (newPhrase)
     {
-        highlightWord("PAST", getRandomColor());
-        highlightWord("MINUTES", getRandomColor());
-        allHighlightedWords += "PASTMINUTES";
+        memset(phraseRgb, 0, sizeof(phraseRgb));
     }
-    else
+    for (uint8_t i = newPhrase ? 0 : slotWords; i < phrase.wordCount; ++i)
     {
-        highlightWord("TO", getRandomColor());
-        highlightWord("MINUTES", getRandomColor());
-        allHighlightedWords += "TOMINUTES";
-        hour = (hour + 1) % 12;
-        if (hour == 0)
-            hour = 12;
+        uint32_t color = i < slotWords ? getRandomColor() : MINUTE_DOT_COLOR;
+        const WordSpan &span = WORD_SPANS[static_cast<uint8_t>(phrase.words[i])];
+        for (uint8_t led = span.start; led <= span.end; ++led)
+        {
+            phraseRgb[led * 3] = color >> 16;
+            phraseRgb[led * 3 + 1] = color >> 8;
+            phraseRgb[led * 3 + 2] = color;
+        }
     }
 
-    String hourWord = "HOUR_" + String(hour);
-    highlightWord(getMinutesWord(minute), getRandomColor());
-    allHighlightedWords += getMinutesWord(minute);
-    highlightWord(hourWord, getRandomColor());
-    allHighlightedWords += hourWord;
-
-    if (allLastHighlightedWords != allHighlightedWords)
+    // After a GIF or effect the old words are long gone, so fade in from black
+    if (lastPhraseIndex < 0)
     {
-        clockDisplayHAL->show();
-        allLastHighlightedWords = allHighlightedWords;
+        clockDisplayHAL->clearLayer(Layer::TEXT);
     }
+    phraseTransition->begin(newPhrase ? PHRASE_TRANSITION : MINUTE_TRANSITION, phrase.mask, phraseRgb, PHRASE_TRANSITION_MS);
+    scheduler->play(phraseTransition);
+    lastPhraseIndex = index;
+    lastMinuteDots = dots;
 }
@@ -4,27 +4,87 @@
 #include <Arduino.h>
 #include "ClockDisplayHAL.h"
 #include "NetworkManager.h"
+#include "NetworkTask.h"
 #include "GifPlayer.h"
+#include "ClipPlayer.h"
 #include "DisplayEffects.h"
+#include "PhraseTransition.h"
+#include "TimePhrases.h"
+#include "FrameScheduler.h"
+
+// GIFs played on the hour
+extern const char *GIF_URLS[];
+extern const int NUM_GIFS;
+
+struct PrefetchStats
+{
+    uint32_t hits;
+    uint32_t misses;
+    unsigned long lastLeadMs; // how long the last hit sat decoded before the hour
+    unsigned long minLeadMs;
+};
 
 class WordClock
 {
 public:
-    WordClock(ClockDisplayHAL *clockDisplayHAL, WiFiTimeManager *networkManager, GifPlayer *gifPlayer, DisplayEffects *displayEffects);
+    // minutePrecision lights one minute dot per minute past the 5-minute phrase
+    WordClock(ClockDisplayHAL *clockDisplayHAL, WiFiTimeManager *networkManager, NetworkTask *networkTask, GifPlayer *gifPlayer, ClipPlayer *clipPlayer, DisplayEffects *displayEffects, PhraseTransition *phraseTransition, FrameScheduler *scheduler, bool minutePrecision = false);
     void setup();
+    // Called on every wake: picks up network results, advances a running animation
+    // or refreshes the time. Never waits on the network. When idle it sets the
+    // scheduler to wake at the next phrase (or, with minute precision, minute) change.
+    void update(unsigned long now);
     void displayTime();
+    const PrefetchStats &getPrefetchStats() const;
 
 private:
     int lastHour;
-    String allLastHighlightedWords;
+    int lastPhraseIndex;
+    int lastMinuteDots;
+    bool minutePrecision;
     ClockDisplayHAL *clockDisplayHAL;
     WiFiTimeManager *networkManager;
+    NetworkTask *networkTask;
     GifPlayer *gifPlayer;
+    ClipPlayer *clipPlayer;
     DisplayEffects *displayEffects;
+    PhraseTransition *phraseTransition;
+    FrameScheduler *scheduler;
+
+    static const TransitionType PHRASE_TRANSITION = TransitionType::RANDOM;
+    static const unsigned long PHRASE_TRANSITION_MS = 800;
+    // A new minute only adds a dot; the words keep their colours
+    static const TransitionType MINUTE_TRANSITION = TransitionType::CROSSFADE;
+    static const uint32_t MINUTE_DOT_COLOR = 0xFFFFFF;
+
+    // GIF requested from the network task and not answered yet
+    const char *pendingGif;
+    unsigned long pendingSince;
+    bool pendingPrefetch;
+    // An answer later than this would land well past the hour; show the time instead
+    static const unsigned long GIF_MAX_WAIT_MS = 60000;
+
+    // The next hour's GIF is fetched and decoded this many minutes early
+    static const int PREFETCH_LEAD_MINUTES = 5;
+    static const unsigned long PREFETCH_RETRY_MS = 60000;
+    int prefetchHour; // hour the prefetched or pending GIF is for, -1 if none
+    Animation *prefetched;
+    unsigned long prefetchedAt;
+    unsigned long lastPrefetchAttempt;
+    PrefetchStats prefetchStats;
+
+    // Colours of the words on screen, so a minute change leaves them as they are
+    uint8_t phraseRgb[ClockDisplayHAL::NUM_LEDS * 3];
 
-    void downloadAndPlayRandomGIF();
-    void highlightWord(const String &word, uint32_t color = 0xFFFFFF);
-    String getMinutesWord(int minute);
+    bool requestRandomGIF(bool prefetch);
+    unsigned long msUntilNextWake(const struct tm &currentTime, uint16_t milliseconds) const;
+    // True when an hourly GIF started playing; loading it can take long enough to make `now` stale
+    bool handleNetworkEvents(unsigned long now);
+    void schedulePrefetch(int hour, int minute);
+    void preparePrefetch(const NetworkEvent &event);
+    bool playHourlyGIF(int hour);
+    bool startGIF(Animation *animation);
+    Animation *loadGIF(const NetworkEvent &event);
     uint32_t getRandomColor();
 };
 
@@ -0,0 +1,185 @@
+#ifndef WORD_LAYOUT_H
+#define WORD_LAYOUT_H
+
+#include <stdint.h>
+
+// Grid size, words and phrases come from the layout tables generated by
+// tools/generate_layout.py; everything else here is derived from them.
+
+// Set of LED strip indexes, one bit per LED
+struct LedMask
+{
+    static constexpr uint8_t WORDS = 5; // 160 bits, enough for a 12x11 grid and spare LEDs
+
+    uint32_t bits[WORDS];
+
+    static constexpr LedMask range(uint8_t start, uint8_t end)
+    {
+        LedMask mask{};
+        for (uint8_t i = start; i <= end; ++i)
+        {
+            mask.bits[i >> 5] |= 1UL << (i & 31);
+        }
+        return mask;
+    }
+
+    constexpr bool test(uint8_t index) const
+    {
+        return (bits[index >> 5] >> (index & 31)) & 1;
+    }
+
+    constexpr bool empty() const
+    {
+        for (uint8_t i = 0; i < WORDS; ++i)
+        {
+            if (bits[i] != 0)
+                return false;
+        }
+        return true;
+    }
+
+    constexpr LedMask &operator|=(const LedMask &other)
+    {
+        for (uint8_t i = 0; i < WORDS; ++i)
+        {
+            bits[i] |= other.bits[i];
+        }
+        return *this;
+    }
+
+    constexpr LedMask operator|(const LedMask &other) const
+    {
+        LedMask result = *this;
+        result |= other;
+        return result;
+    }
+
+    constexpr bool operator==(const LedMask &other) const
+    {
+        for (uint8_t i = 0; i < WORDS; ++i)
+        {
+            if (bits[i] != other.bits[i])
+                return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const LedMask &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+struct WordSpan
+{
+    uint8_t start;
+    uint8_t end;
+};
+
+// PlatformIO builds of a layout other than the committed one include tables
+// generated into the build directory (tools/platformio_layout.py)
+#ifdef WORD_LAYOUT_TABLES
+#include WORD_LAYOUT_TABLES
+#else
+#include "WordLayoutTables.h"
+#endif
+
+constexpr uint8_t LED_COUNT = GRID_WIDTH * GRID_HEIGHT;
+
+static_assert(GRID_WIDTH * GRID_HEIGHT <= LedMask::WORDS * 32, "LedMask must hold every LED");
+
+// Strip index of every grid cell, row-major from the top left. The strip
+// snakes up from the bottom right: rows counted from the top run right to
+// left when even and left to right when odd.
+struct GridIndexTable
+{
+    uint8_t index[GRID_HEIGHT][GRID_WIDTH];
+};
+
+constexpr GridIndexTable buildGridIndexTable()
+{
+    GridIndexTable table{};
+    for (uint8_t y = 0; y < GRID_HEIGHT; ++y)
+    {
+        for (uint8_t x = 0; x < GRID_WIDTH; ++x)
+        {
+            table.index[y][x] = y % 2 == 0 ? LED_COUNT - y * GRID_WIDTH - (x + 1)
+                                           : LED_COUNT - (y + 1) * GRID_WIDTH + x;
+        }
+    }
+    return table;
+}
+
+inline constexpr GridIndexTable GRID_TO_LED = buildGridIndexTable();
+
+static_assert(GRID_TO_LED.index[0][0] == LED_COUNT - 1 && GRID_TO_LED.index[0][GRID_WIDTH - 1] == LED_COUNT - GRID_WIDTH, "top row runs right to left");
+static_assert(GRID_TO_LED.index[1][0] == LED_COUNT - 2 * GRID_WIDTH && GRID_TO_LED.index[1][GRID_WIDTH - 1] == LED_COUNT - GRID_WIDTH - 1, "second row runs left to right");
+
+struct GridCoord
+{
+    uint8_t x;
+    uint8_t y;
+};
+
+// Inverse of GRID_TO_LED
+struct LedCoordTable
+{
+    GridCoord coord[LED_COUNT];
+};
+
+constexpr LedCoordTable buildLedCoordTable()
+{
+    LedCoordTable table{};
+    for (uint8_t y = 0; y < GRID_HEIGHT; ++y)
+    {
+        for (uint8_t x = 0; x < GRID_WIDTH; ++x)
+        {
+            table.coord[GRID_TO_LED.index[y][x]] = {x, y};
+        }
+    }
+    return table;
+}
+
+inline constexpr LedCoordTable LED_TO_GRID = buildLedCoordTable();
+
+static_assert(LED_TO_GRID.coord[LED_COUNT - 1].x == 0 && LED_TO_GRID.coord[LED_COUNT - 1].y == 0,
+              "LED_TO_GRID inverts GRID_TO_LED");
+
+struct WordMaskTable
+{
+    LedMask masks[WORD_COUNT];
+};
+
+constexpr WordMaskTable buildWordMaskTable()
+{
+    WordMaskTable table{};
+    for (uint8_t i = 0; i < WORD_COUNT; ++i)
+    {
+        table.masks[i] = LedMask::range(WORD_SPANS[i].start, WORD_SPANS[i].end);
+    }
+    return table;
+}
+
+inline constexpr WordMaskTable WORD_MASKS = buildWordMaskTable();
+
+constexpr const LedMask &wordMask(WordId word)
+{
+    return WORD_MASKS.masks[static_cast<uint8_t>(word)];
+}
+
+constexpr LedMask phraseMask(const WordId *words, uint8_t count)
+{
+    LedMask mask{};
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        mask |= wordMask(words[i]);
+    }
+    return mask;
+}
+
+#ifdef WORD_LAYOUT_ENGLISH
+static_assert(wordMask(WordId::TWENTYFIVE) == (wordMask(WordId::TWENTY) | wordMask(WordId::FIVE)), "TWENTYFIVE must cover TWENTY and FIVE");
+static_assert(wordMask(WordId::IT).test(131) && !wordMask(WordId::IT).test(129), "IT spans LEDs 130-131");
+#endif
+
+#endif
@@ -0,0 +1,252 @@
+// Generated by tools/generate_layout.py from layouts/english.json; do not edit.
+// Included by WordLayout.h, which declares WordSpan.
+
+/*
+Display letters and LED strip indexes
+
+131 ITLISASTHPMA 120
+108 ACFIFTEENDCO 119
+107 TWENTYFIVEXW 096
+084 THIRTYXTENXW 095
+083 MINUTESETOUR 072
+060 PASTORUFOURT 071
+059 SEVENXTWELVE 048
+036 NINEFIVECTWO 047
+035 EIGHTFELEVEN 024
+012 SIXTHREEONEG 023
+011 TENSEZOCLOCK 000
+*/
+
+#define WORD_LAYOUT_ENGLISH 1
+
+constexpr uint8_t GRID_WIDTH = 12;
+constexpr uint8_t GRID_HEIGHT = 11;
+
+enum class WordId : uint8_t
+{
+    HOUR_1,
+    HOUR_2,
+    HOUR_3,
+    HOUR_4,
+    HOUR_5,
+    HOUR_6,
+    HOUR_7,
+    HOUR_8,
+    HOUR_9,
+    HOUR_10,
+    HOUR_11,
+    HOUR_12,
+    OCLOCK,
+    PAST,
+    TO,
+    MINUTES,
+    THIRTY,
+    TWENTY,
+    TWENTYFIVE,
+    FIVE,
+    TEN,
+    FIFTEEN,
+    IS,
+    IT,
+    DOT_1,
+    DOT_2,
+    DOT_3,
+    DOT_4,
+    COUNT
+};
+
+constexpr uint8_t WORD_COUNT = static_cast<uint8_t>(WordId::COUNT);
+
+// Inclusive LED ranges, indexed by WordId
+inline constexpr WordSpan WORD_SPANS[WORD_COUNT] = {
+    {20, 22},   // HOUR_1
+    {45, 47},   // HOUR_2
+    {15, 19},   // HOUR_3
+    {67, 70},   // HOUR_4
+    {40, 43},   // HOUR_5
+    {12, 14},   // HOUR_6
+    {55, 59},   // HOUR_7
+    {31, 35},   // HOUR_8
+    {36, 39},   // HOUR_9
+    {9, 11},    // HOUR_10
+    {24, 29},   // HOUR_11
+    {48, 53},   // HOUR_12
+    {0, 5},     // OCLOCK
+    {60, 63},   // PAST
+    {63, 64},   // TO
+    {77, 83},   // MINUTES
+    {84, 89},   // THIRTY
+    {102, 107}, // TWENTY
+    {98, 107},  // TWENTYFIVE
+    {98, 101},  // FIVE
+    {91, 93},   // TEN
+    {110, 116}, // FIFTEEN
+    {127, 128}, // IS
+    {130, 131}, // IT
+    {123, 123}, // DOT_1
+    {122, 122}, // DOT_2
+    {121, 121}, // DOT_3
+    {120, 120}  // DOT_4
+};
+
+// Words of every 5-minute slot of a 12-hour day, index hour * 12 + minute / 5
+constexpr uint8_t LAYOUT_PHRASE_MAX_WORDS = 6;
+constexpr uint8_t LAYOUT_PHRASE_COUNT = 144;
+
+struct LayoutPhrase
+{
+    WordId words[LAYOUT_PHRASE_MAX_WORDS];
+    uint8_t wordCount;
+};
+
+inline constexpr LayoutPhrase LAYOUT_PHRASES[LAYOUT_PHRASE_COUNT] = {
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_12}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_1}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_1}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_2}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_2}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_3}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_3}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_4}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_4}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_5}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_5}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_6}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_6}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_7}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_7}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_8}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_8}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_9}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_9}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_10}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_10}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::OCLOCK, WordId::HOUR_11}, 4},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIVE, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TEN, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::PAST, WordId::MINUTES, WordId::THIRTY, WordId::HOUR_11}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTYFIVE, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TWENTY, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIFTEEN, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::TEN, WordId::HOUR_12}, 6},
+    {{WordId::IT, WordId::IS, WordId::TO, WordId::MINUTES, WordId::FIVE, WordId::HOUR_12}, 6}
+};
+
+// Spare letters lit one per minute past the 5-minute slot
+constexpr uint8_t LAYOUT_MINUTE_DOT_COUNT = 4;
+
+inline constexpr WordId LAYOUT_MINUTE_DOTS[LAYOUT_MINUTE_DOT_COUNT] = {WordId::DOT_1, WordId::DOT_2, WordId::DOT_3, WordId::DOT_4};
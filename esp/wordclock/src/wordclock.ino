@@ -1,29 +1,71 @@
 #include <Arduino.h>
 #include "ClockDisplayHAL.h"
 #include "NetworkManager.h"
+#include "NetworkTask.h"
 #include "SerialHelper.h"
 #include "config.h"
 #include "GifPlayer.h"
 #include "DisplayEffects.h"
 #include "WordClock.h"
+#include "FrameScheduler.h"
+#include "GifCache.h"
+#include "ClipPlayer.h"
+#include "PhraseTransition.h"
+#include "FrameBenchmark.h"
+#include "AutoBrightness.h"
+
+#ifndef LED_BACKEND
+#define LED_BACKEND LedBackend::NEOPIXEL
+#endif
+#ifndef LDR_PIN
+#define LDR_PIN -1
+#endif
+#ifndef DIM_AT_NIGHT
+#define DIM_AT_NIGHT 0
+#endif
+#ifndef BRIGHTNESS_MIN
+#define BRIGHTNESS_MIN 8
+#endif
+#ifndef BRIGHTNESS_MAX
+#define BRIGHTNESS_MAX 255
+#endif
+#ifndef MINUTE_PRECISION
+#define MINUTE_PRECISION 0
+#endif
 
 WiFiTimeManager networkManager(WIFI_SSID, WIFI_PASSWORD, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC);
-ClockDisplayHAL clockDisplayHAL(LED_PIN, 255);
+ClockDisplayHAL clockDisplayHAL(LED_PIN, BRIGHTNESS_MAX, LED_BACKEND);
 GifPlayer gifPlayer(&clockDisplayHAL);
+ClipPlayer clipPlayer(&clockDisplayHAL);
 DisplayEffects displayEffects(&clockDisplayHAL);
-WordClock wordClock(&clockDisplayHAL, &networkManager, &gifPlayer, &displayEffects);
+PhraseTransition phraseTransition(&clockDisplayHAL);
+GifCache gifCache;
+FrameScheduler frameScheduler(20, 60000); // 50 FPS while animating, otherwise until the next phrase change
+NetworkTask networkTask(&networkManager, &gifCache, &frameScheduler);
+WordClock wordClock(&clockDisplayHAL, &networkManager, &networkTask, &gifPlayer, &clipPlayer, &displayEffects, &phraseTransition, &frameScheduler, MINUTE_PRECISION);
+AutoBrightness autoBrightness(&clockDisplayHAL, &networkManager, &frameScheduler, LDR_PIN, DIM_AT_NIGHT, BRIGHTNESS_MIN, BRIGHTNESS_MAX);
 
 void setup()
 {
   initSerial();
-  networkManager.setup();
   clockDisplayHAL.setup();
+  gifCache.begin();
+  networkManager.setup();
+#ifdef BENCHMARK_FRAMES
+  networkManager.waitForConnection(30000);
+  FrameBenchmark(&clockDisplayHAL, &displayEffects, &gifPlayer, &clipPlayer, &gifCache).run(BENCHMARK_FRAMES);
+#endif
+  frameScheduler.begin();
+  networkTask.begin();
   wordClock.setup();
+  autoBrightness.begin();
 }
 
 void loop()
 {
-  networkManager.update();
-  wordClock.displayTime();
-  delay(1000);
+  unsigned long frameStart = millis();
+  networkTask.poll();
+  wordClock.update(frameStart);
+  autoBrightness.update(frameStart);
+  frameScheduler.sleepUntilNextFrame(frameStart);
 }
@@ -0,0 +1,140 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "ClockDisplayHAL.h"
+#include "GammaTable.h"
+#include "Simulator.h"
+
+// The output stage of ClockDisplayHAL: gamma and brightness in 8.8 fixed
+// point, dithered across pushed frames or rounded. Read back from the frames
+// the simulated strip records.
+
+static const uint8_t BRIGHTNESS = 20;
+static ClockDisplayHAL *hal;
+
+// Exact output of an 8-bit input at BRIGHTNESS, in 1/256ths
+static uint32_t exact(uint8_t value)
+{
+    return ((uint32_t)GAMMA16.values[value] * (BRIGHTNESS + 1)) >> 8;
+}
+
+static uint8_t outputRed(uint16_t led)
+{
+    return Simulator::frames().back().pixels[led] >> 16;
+}
+
+// LED 0 holds value while LED 1 changes, so every frame is pushed
+static void pushFrame(uint8_t value, uint16_t frame)
+{
+    hal->pixels.setPixelColor(0, value, 0, 0);
+    hal->pixels.setPixelColor(1, 0, 0, frame & 1 ? 255 : 0);
+    hal->markDirty();
+    hal->show();
+}
+
+void setUp(void)
+{
+    hal = new ClockDisplayHAL(0, BRIGHTNESS);
+    hal->setup();
+}
+
+void tearDown(void)
+{
+    delete hal;
+    Simulator::clearFrames();
+}
+
+void test_dithered_frames_average_to_the_exact_value(void)
+{
+    const uint8_t value = 128;
+    TEST_ASSERT_TRUE(exact(value) % 256 != 0);
+
+    uint32_t sum = 0;
+    uint8_t lowest = 255, highest = 0;
+    for (uint16_t frame = 0; frame < 256; ++frame)
+    {
+        pushFrame(value, frame);
+        uint8_t out = outputRed(0);
+        sum += out;
+        lowest = out < lowest ? out : lowest;
+        highest = out > highest ? out : highest;
+    }
+    TEST_ASSERT_EQUAL_UINT32(exact(value), sum);
+    TEST_ASSERT_EQUAL_UINT8(exact(value) / 256, lowest);
+    TEST_ASSERT_EQUAL_UINT8(exact(value) / 256 + 1, highest);
+}
+
+void test_without_dithering_output_is_rounded(void)
+{
+    hal->setDithering(false);
+    for (uint16_t frame = 0; frame < 8; ++frame)
+    {
+        pushFrame(128, frame);
+        TEST_ASSERT_EQUAL_UINT8((exact(128) + 128) / 256, outputRed(0));
+    }
+}
+
+void test_strip_buffer_keeps_the_uncorrected_frame(void)
+{
+    pushFrame(128, 0);
+    TEST_ASSERT_EQUAL_UINT32(0x800000, hal->pixels.getPixelColor(0));
+}
+
+void test_still_frame_is_pushed_rounded(void)
+{
+    const uint8_t value = 128;
+    const uint8_t rounded = (exact(value) + 128) / 256;
+    // Dither until the frame on the strip is off the rounded value
+    uint16_t frame = 0;
+    do
+    {
+        pushFrame(value, frame++);
+    } while (outputRed(0) == rounded && frame < 256);
+    TEST_ASSERT_NOT_EQUAL(rounded, outputRed(0));
+
+    // Unchanged pixels, yet each still frame is pushed again, rounded
+    for (uint8_t still = 1; still <= 8; ++still)
+    {
+        size_t pushed = Simulator::frames().size();
+        hal->showStill();
+        TEST_ASSERT_EQUAL_size_t(pushed + 1, Simulator::frames().size());
+        TEST_ASSERT_EQUAL_UINT8(rounded, outputRed(0));
+    }
+}
+
+void test_rounded_dim_channels_stay_lit(void)
+{
+    hal->setDithering(false);
+    // Brown: green and blue would round to 0 at this brightness
+    TEST_ASSERT_TRUE(exact(42) < 128);
+    hal->pixels.setPixelColor(0, 165, 42, 42);
+    hal->markDirty();
+    hal->show();
+    uint32_t out = Simulator::frames().back().pixels[0];
+    TEST_ASSERT_EQUAL_UINT8((exact(165) + 128) / 256, out >> 16);
+    TEST_ASSERT_EQUAL_UINT8(1, (out >> 8) & 0xFF);
+    TEST_ASSERT_EQUAL_UINT8(1, out & 0xFF);
+    // Off stays off
+    TEST_ASSERT_EQUAL_UINT32(0, Simulator::frames().back().pixels[1]);
+}
+
+void test_full_brightness_reaches_full_output(void)
+{
+    hal->setBrightness(255);
+    for (uint16_t frame = 0; frame < 8; ++frame)
+    {
+        pushFrame(255, frame);
+        TEST_ASSERT_EQUAL_UINT8(255, outputRed(0));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_dithered_frames_average_to_the_exact_value);
+    RUN_TEST(test_without_dithering_output_is_rounded);
+    RUN_TEST(test_strip_buffer_keeps_the_uncorrected_frame);
+    RUN_TEST(test_still_frame_is_pushed_rounded);
+    RUN_TEST(test_rounded_dim_channels_stay_lit);
+    RUN_TEST(test_full_brightness_reaches_full_output);
+    return UNITY_END();
+}
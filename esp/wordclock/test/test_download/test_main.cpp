@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "NetworkManager.h"
+#include "Simulator.h"
+
+// WiFiTimeManager::downloadGIF against the simulated server, which frames a
+// chunked body in 1000-byte chunks and can trickle it in at a fixed rate.
+
+static const size_t MAX_GIF_SIZE = 32768;
+
+static char httpRoot[] = "/tmp/wordclock_download_XXXXXX";
+static WiFiTimeManager *manager;
+
+static std::vector<uint8_t> serve(const char *name, size_t size)
+{
+    std::vector<uint8_t> body(size);
+    uint32_t state = size;
+    for (uint8_t &byte : body)
+    {
+        state = state * 1103515245u + 12345u;
+        byte = state >> 24;
+    }
+    std::string path = std::string(httpRoot) + "/" + name;
+    FILE *file = fopen(path.c_str(), "wb");
+    fwrite(body.data(), 1, body.size(), file);
+    fclose(file);
+    return body;
+}
+
+static void assertDownloaded(const std::vector<uint8_t> &body)
+{
+    TEST_ASSERT_EQUAL_size_t(body.size(), manager->getGifBufferSize());
+    TEST_ASSERT_EQUAL_MEMORY(body.data(), manager->getGifBuffer(), body.size());
+    TEST_ASSERT_EQUAL(body.size(), manager->getLastDownloadStats().bytes);
+}
+
+void setUp(void)
+{
+    Simulator::setHttpRoot(httpRoot);
+    Simulator::setHttpChunked(false);
+    Simulator::setHttpCloseDelimited(false);
+    Simulator::setHttpBytesPerMs(0);
+    Simulator::setHttpLatency(0);
+}
+
+void tearDown(void) {}
+
+void test_plain_body(void)
+{
+    std::vector<uint8_t> body = serve("plain.gif", 4500);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/plain.gif"));
+    assertDownloaded(body);
+    TEST_ASSERT_FALSE(manager->getLastDownloadStats().chunked);
+}
+
+void test_chunked_body_ending_in_a_partial_chunk(void)
+{
+    std::vector<uint8_t> body = serve("partial.gif", 4500);
+    Simulator::setHttpChunked(true);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/partial.gif"));
+    assertDownloaded(body);
+    TEST_ASSERT_TRUE(manager->getLastDownloadStats().chunked);
+}
+
+void test_chunked_body_of_whole_chunks(void)
+{
+    std::vector<uint8_t> body = serve("whole.gif", 3000);
+    Simulator::setHttpChunked(true);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/whole.gif"));
+    assertDownloaded(body);
+}
+
+void test_chunked_body_arriving_a_few_bytes_at_a_time(void)
+{
+    // Size lines and chunk ends then straddle reads
+    std::vector<uint8_t> body = serve("slow.gif", 2500);
+    Simulator::setHttpChunked(true);
+    Simulator::setHttpBytesPerMs(3);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/slow.gif"));
+    assertDownloaded(body);
+}
+
+void test_chunked_body_over_the_size_limit(void)
+{
+    // Without a Content-Length the limit can only be enforced chunk by chunk
+    serve("large.gif", 40000);
+    Simulator::setHttpChunked(true);
+    TEST_ASSERT_FALSE(manager->downloadGIF("http://sim/large.gif"));
+    TEST_ASSERT_EQUAL_size_t(0, manager->getGifBufferSize());
+}
+
+void test_body_ended_by_closing_the_connection(void)
+{
+    std::vector<uint8_t> body = serve("closed.gif", 5000);
+    Simulator::setHttpCloseDelimited(true);
+    Simulator::setHttpBytesPerMs(3);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/closed.gif"));
+    assertDownloaded(body);
+}
+
+void test_body_ended_by_closing_the_connection_filling_the_buffer(void)
+{
+    std::vector<uint8_t> body = serve("full.gif", MAX_GIF_SIZE);
+    Simulator::setHttpCloseDelimited(true);
+    TEST_ASSERT_TRUE(manager->downloadGIF("http://sim/full.gif"));
+    assertDownloaded(body);
+}
+
+void test_body_ended_by_closing_the_connection_over_the_size_limit(void)
+{
+    // A truncated GIF must not pass for the whole one
+    serve("over.gif", MAX_GIF_SIZE + 1);
+    Simulator::setHttpCloseDelimited(true);
+    TEST_ASSERT_FALSE(manager->downloadGIF("http://sim/over.gif"));
+    TEST_ASSERT_EQUAL_size_t(0, manager->getGifBufferSize());
+}
+
+void test_missing_file(void)
+{
+    TEST_ASSERT_FALSE(manager->downloadGIF("http://sim/missing.gif"));
+}
+
+int main(int argc, char **argv)
+{
+    TEST_ASSERT_NOT_NULL(mkdtemp(httpRoot));
+    manager = new WiFiTimeManager((char *)"sim", (char *)"", 0, 0);
+    WiFi.begin("sim");
+
+    UNITY_BEGIN();
+    RUN_TEST(test_plain_body);
+    RUN_TEST(test_chunked_body_ending_in_a_partial_chunk);
+    RUN_TEST(test_chunked_body_of_whole_chunks);
+    RUN_TEST(test_chunked_body_arriving_a_few_bytes_at_a_time);
+    RUN_TEST(test_chunked_body_over_the_size_limit);
+    RUN_TEST(test_body_ended_by_closing_the_connection);
+    RUN_TEST(test_body_ended_by_closing_the_connection_filling_the_buffer);
+    RUN_TEST(test_body_ended_by_closing_the_connection_over_the_size_limit);
+    RUN_TEST(test_missing_file);
+    return UNITY_END();
+}
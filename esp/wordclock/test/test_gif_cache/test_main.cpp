@@ -0,0 +1,261 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <utime.h>
+#include <LittleFS.h>
+#include "GifCache.h"
+#include "Simulator.h"
+
+// GifCache against the simulated server, whose ETags are quoted 64-hex-digit
+// hashes like raw.githubusercontent's. The copy on flash is overwritten
+// with same-length bytes after each download: a 304 leaves them in place, a
+// 200 replaces them with the served file, which tells the two apart.
+
+static char httpRoot[] = "/tmp/wordclock_cache_http_XXXXXX";
+static const char *URL = "http://sim/hour.gif";
+static GifCache *cache;
+
+static std::string servedPath()
+{
+    return std::string(httpRoot) + "/hour.gif";
+}
+
+static void serve(const std::string &content, const char *name = "hour.gif")
+{
+    FILE *file = fopen((std::string(httpRoot) + "/" + name).c_str(), "wb");
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+}
+
+// Same content under a new Last-Modified, so only the ETag can still match
+static void touch()
+{
+    struct utimbuf times = {1700000000, 1700000000};
+    utime(servedPath().c_str(), &times);
+}
+
+static std::string readFlash(const std::string &path)
+{
+    File file = LittleFS.open(path.c_str());
+    std::string content(file.size(), '\0');
+    file.read((uint8_t *)&content[0], content.size());
+    return content;
+}
+
+// Fetches URL and marks the copy on flash
+static std::string fetchAndMark()
+{
+    const char *path = cache->fetch(URL);
+    TEST_ASSERT_NOT_NULL(path);
+    std::string content = readFlash(path);
+    File file = LittleFS.open(path, FILE_WRITE);
+    file.write((const uint8_t *)std::string(content.size(), '#').data(), content.size());
+    file.close();
+    return path;
+}
+
+static bool markKept(const std::string &path)
+{
+    std::string content = readFlash(path);
+    return !content.empty() && content == std::string(content.size(), '#');
+}
+
+static void advanceDays(uint32_t days)
+{
+    Simulator::setEpoch(Simulator::now() + days * GifCache::REVALIDATE_INTERVAL_SEC);
+}
+
+void setUp(void)
+{
+    // A fresh partition per test
+    char flashRoot[] = "/tmp/wordclock_cache_flash_XXXXXX";
+    TEST_ASSERT_NOT_NULL(mkdtemp(flashRoot));
+    Simulator::setFlashRoot(flashRoot);
+    TEST_ASSERT_TRUE(LittleFS.begin(true));
+    cache = new GifCache();
+    TEST_ASSERT_TRUE(cache->begin());
+}
+
+void tearDown(void)
+{
+    delete cache;
+}
+
+void test_store_header(void)
+{
+    char field[8];
+    TEST_ASSERT_TRUE(GifCache::storeHeader(field, sizeof(field), "\"abcde\""));
+    TEST_ASSERT_EQUAL_STRING("\"abcde\"", field);
+    TEST_ASSERT_TRUE(GifCache::storeHeader(field, sizeof(field), ""));
+    TEST_ASSERT_EQUAL_STRING("", field);
+
+    // Truncated, it would be sent back as a validator that never matches
+    TEST_ASSERT_FALSE(GifCache::storeHeader(field, sizeof(field), "\"abcdef\""));
+    TEST_ASSERT_EQUAL_STRING("", field);
+}
+
+void test_first_fetch_downloads(void)
+{
+    serve("first");
+    const char *path = cache->fetch(URL);
+    TEST_ASSERT_NOT_NULL(path);
+    TEST_ASSERT_EQUAL_STRING("first", readFlash(path).c_str());
+    TEST_ASSERT_EQUAL_size_t(5, cache->usedBytes());
+}
+
+void test_fresh_copy_is_served_without_a_request(void)
+{
+    serve("first");
+    std::string path = fetchAndMark();
+
+    serve("second");
+    TEST_ASSERT_EQUAL_STRING(path.c_str(), cache->fetch(URL));
+    TEST_ASSERT_TRUE(markKept(path));
+}
+
+void test_unchanged_copy_revalidates_by_etag(void)
+{
+    serve("unchanged");
+    std::string path = fetchAndMark();
+
+    touch();
+    advanceDays(1);
+    TEST_ASSERT_EQUAL_STRING(path.c_str(), cache->fetch(URL));
+    TEST_ASSERT_TRUE(markKept(path));
+}
+
+void test_etag_survives_a_restart(void)
+{
+    serve("unchanged");
+    std::string path = fetchAndMark();
+
+    delete cache;
+    cache = new GifCache();
+    TEST_ASSERT_TRUE(cache->begin());
+    touch();
+    advanceDays(1);
+    TEST_ASSERT_EQUAL_STRING(path.c_str(), cache->fetch(URL));
+    TEST_ASSERT_TRUE(markKept(path));
+}
+
+void test_changed_copy_is_downloaded_again(void)
+{
+    serve("before");
+    std::string path = fetchAndMark();
+
+    serve("after");
+    advanceDays(1);
+    TEST_ASSERT_EQUAL_STRING(path.c_str(), cache->fetch(URL));
+    TEST_ASSERT_EQUAL_STRING("after", readFlash(path).c_str());
+}
+
+void test_offline_serves_the_stale_copy(void)
+{
+    serve("cached");
+    std::string path = fetchAndMark();
+
+    WiFi.disconnect();
+    advanceDays(1);
+    TEST_ASSERT_EQUAL_STRING(path.c_str(), cache->fetch(URL));
+    TEST_ASSERT_TRUE(markKept(path));
+    WiFi.begin("sim");
+}
+
+void test_incomplete_download_evicts_nothing(void)
+{
+    const char *names[] = {"a.gif", "b.gif", "c.gif"};
+    char url[32];
+    for (const char *name : names)
+    {
+        serve(std::string(80 * 1024, name[0]), name);
+        snprintf(url, sizeof(url), "http://sim/%s", name);
+        TEST_ASSERT_NOT_NULL(cache->fetch(url));
+    }
+
+    // Room for it means evicting a.gif, but only once it has all arrived
+    serve(std::string(70 * 1024, 'd'), "d.gif");
+    Simulator::setHttpDropAfter(30 * 1024);
+    TEST_ASSERT_NULL(cache->fetch("http://sim/d.gif"));
+    Simulator::setHttpDropAfter(0);
+    TEST_ASSERT_TRUE(cache->contains("http://sim/a.gif"));
+    TEST_ASSERT_EQUAL_size_t(240 * 1024, cache->usedBytes());
+
+    TEST_ASSERT_NOT_NULL(cache->fetch("http://sim/d.gif"));
+    TEST_ASSERT_FALSE(cache->contains("http://sim/a.gif"));
+    TEST_ASSERT_TRUE(cache->contains("http://sim/b.gif"));
+}
+
+void test_restart_removes_files_no_entry_owns(void)
+{
+    serve("kept");
+    std::string path = cache->fetch(URL);
+    std::string clipPath = path.substr(0, path.size() - 3) + "clip";
+    const char *orphans[] = {"/gifcache/0badf00d.gif", "/gifcache/0badf00d.clip", "/gifcache/stream.gif",
+                             "/gifcache/stream.clip", "/gifcache/download.tmp", clipPath.c_str()};
+    for (const char *orphan : orphans)
+    {
+        File file = LittleFS.open(orphan, FILE_WRITE);
+        file.write((const uint8_t *)"orphan", 6);
+        file.close();
+    }
+
+    delete cache;
+    cache = new GifCache();
+    TEST_ASSERT_TRUE(cache->begin());
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        TEST_ASSERT_FALSE(LittleFS.exists(orphans[i]));
+    }
+    // The entry keeps its GIF and clip
+    TEST_ASSERT_TRUE(LittleFS.exists(clipPath.c_str()));
+    TEST_ASSERT_EQUAL_STRING("kept", readFlash(path).c_str());
+    TEST_ASSERT_TRUE(cache->contains(URL));
+}
+
+void test_gif_too_large_for_the_cache_streams_to_a_scratch_file(void)
+{
+    serve("small");
+    cache->fetch(URL);
+    TEST_ASSERT_TRUE(cache->contains(URL));
+
+    // The same URL grows past the cache; the outdated entry goes
+    std::string large(GifCache::MAX_BYTES + 1000, 'L');
+    serve(large);
+    advanceDays(1);
+    const char *path = cache->fetch(URL);
+    TEST_ASSERT_NOT_NULL(path);
+    TEST_ASSERT_TRUE(readFlash(path) == large);
+    TEST_ASSERT_FALSE(cache->contains(URL));
+    TEST_ASSERT_EQUAL_size_t(0, cache->usedBytes());
+
+    // The next one replaces it
+    std::string other(GifCache::MAX_BYTES + 2000, 'O');
+    serve(other, "other.gif");
+    std::string otherPath = cache->fetch("http://sim/other.gif");
+    TEST_ASSERT_EQUAL_STRING(path, otherPath.c_str());
+    TEST_ASSERT_TRUE(readFlash(otherPath) == other);
+}
+
+int main(int argc, char **argv)
+{
+    TEST_ASSERT_NOT_NULL(mkdtemp(httpRoot));
+    Simulator::setHttpRoot(httpRoot);
+    Simulator::setEpoch(1760000000);
+    configTime(0, 0, "pool.ntp.org");
+    WiFi.begin("sim");
+
+    UNITY_BEGIN();
+    RUN_TEST(test_store_header);
+    RUN_TEST(test_first_fetch_downloads);
+    RUN_TEST(test_fresh_copy_is_served_without_a_request);
+    RUN_TEST(test_unchanged_copy_revalidates_by_etag);
+    RUN_TEST(test_etag_survives_a_restart);
+    RUN_TEST(test_changed_copy_is_downloaded_again);
+    RUN_TEST(test_offline_serves_the_stale_copy);
+    RUN_TEST(test_incomplete_download_evicts_nothing);
+    RUN_TEST(test_restart_removes_files_no_entry_owns);
+    RUN_TEST(test_gif_too_large_for_the_cache_streams_to_a_scratch_file);
+    return UNITY_END();
+}
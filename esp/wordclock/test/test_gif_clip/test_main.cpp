@@ -0,0 +1,254 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <stdlib.h>
+#include <vector>
+#include <LittleFS.h>
+#include "GifClip.h"
+#include "Simulator.h"
+
+// GifClip encoding, the file round trip through LittleFS and playback
+
+static const size_t CANVAS_BYTES = GifClip::PIXELS * 3;
+static char flashRoot[] = "/tmp/wordclock_clip_XXXXXX";
+
+static void fill(uint8_t *canvas, uint8_t r, uint8_t g, uint8_t b)
+{
+    for (uint16_t i = 0; i < GifClip::PIXELS; ++i)
+    {
+        canvas[i * 3] = r;
+        canvas[i * 3 + 1] = g;
+        canvas[i * 3 + 2] = b;
+    }
+}
+
+static void setColor(uint8_t *canvas, uint16_t pixel, uint8_t r, uint8_t g, uint8_t b)
+{
+    canvas[pixel * 3] = r;
+    canvas[pixel * 3 + 1] = g;
+    canvas[pixel * 3 + 2] = b;
+}
+
+// Each pixel its own color, offset so two calls need more than 256 colors together
+static void gradient(uint8_t *canvas, uint16_t offset)
+{
+    for (uint16_t i = 0; i < GifClip::PIXELS; ++i)
+    {
+        setColor(canvas, i, i + offset, (i + offset) >> 8, 7);
+    }
+}
+
+// Saves a two-colour palette clip: a key frame, then a delta changing one pixel
+static void saveTwoFrameClip(const char *path)
+{
+    static uint8_t canvas[CANVAS_BYTES];
+    GifClip clip;
+    clip.beginEncode(false);
+    fill(canvas, 1, 2, 3);
+    TEST_ASSERT_TRUE(clip.addFrame(canvas, 10));
+    setColor(canvas, 0, 4, 5, 6);
+    TEST_ASSERT_TRUE(clip.addFrame(canvas, 10));
+    TEST_ASSERT_TRUE(clip.endEncode());
+    TEST_ASSERT_TRUE(clip.save(path));
+}
+
+static std::vector<uint8_t> readFile(const char *path)
+{
+    File file = LittleFS.open(path);
+    std::vector<uint8_t> bytes(file.size());
+    file.read(bytes.data(), bytes.size());
+    return bytes;
+}
+
+static void writeFile(const char *path, const std::vector<uint8_t> &bytes)
+{
+    File file = LittleFS.open(path, FILE_WRITE);
+    file.write(bytes.data(), bytes.size());
+    file.close();
+}
+
+static void assertPlaysBack(GifClip &clip, uint8_t frames[][CANVAS_BYTES], const uint16_t *delays, uint16_t count)
+{
+    uint8_t canvas[CANVAS_BYTES] = {};
+    uint16_t delayMs = 0;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        TEST_ASSERT_TRUE(clip.nextFrame(canvas, delayMs));
+        TEST_ASSERT_EQUAL_UINT16(delays[i], delayMs);
+        TEST_ASSERT_EQUAL_MEMORY(frames[i], canvas, CANVAS_BYTES);
+    }
+    TEST_ASSERT_FALSE(clip.nextFrame(canvas, delayMs));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_palette_clip_round_trip(void)
+{
+    static uint8_t frames[4][CANVAS_BYTES];
+    const uint16_t delays[4] = {100, 40, 65535, 0};
+    fill(frames[0], 10, 20, 30);
+    memcpy(frames[1], frames[0], CANVAS_BYTES);
+    setColor(frames[1], 0, 255, 0, 0);
+    setColor(frames[1], GifClip::PIXELS - 1, 0, 0, 255);
+    fill(frames[2], 1, 2, 3);
+    memcpy(frames[3], frames[2], CANVAS_BYTES);
+
+    GifClip clip;
+    clip.beginEncode(false);
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_TRUE(clip.addFrame(frames[i], delays[i]));
+    }
+    TEST_ASSERT_TRUE(clip.endEncode());
+    TEST_ASSERT_TRUE(clip.save("/round_trip.clip"));
+
+    GifClip loaded;
+    TEST_ASSERT_TRUE(loaded.load("/round_trip.clip"));
+    TEST_ASSERT_EQUAL_UINT16(4, loaded.getFrameCount());
+    TEST_ASSERT_EQUAL_size_t(clip.getSize(), loaded.getSize());
+    assertPlaysBack(loaded, frames, delays, 4);
+
+    loaded.rewind();
+    assertPlaysBack(loaded, frames, delays, 4);
+}
+
+void test_sparse_change_is_a_delta_frame(void)
+{
+    static uint8_t frames[2][CANVAS_BYTES];
+    fill(frames[0], 0, 0, 0);
+    memcpy(frames[1], frames[0], CANVAS_BYTES);
+    setColor(frames[1], 5, 9, 9, 9);
+
+    GifClip keyOnly;
+    keyOnly.beginEncode(false);
+    TEST_ASSERT_TRUE(keyOnly.addFrame(frames[0], 50));
+    TEST_ASSERT_TRUE(keyOnly.endEncode());
+
+    GifClip clip;
+    clip.beginEncode(false);
+    TEST_ASSERT_TRUE(clip.addFrame(frames[0], 50));
+    TEST_ASSERT_TRUE(clip.addFrame(frames[1], 50));
+    TEST_ASSERT_TRUE(clip.endEncode());
+
+    // Delay, type, count, then one index and one palette entry; plus 3 bytes for the new color
+    TEST_ASSERT_EQUAL_size_t(keyOnly.getSize() + 6 + 3, clip.getSize());
+    const uint16_t delays[2] = {50, 50};
+    assertPlaysBack(clip, frames, delays, 2);
+}
+
+void test_palette_overflow_needs_rgb(void)
+{
+    static uint8_t frames[2][CANVAS_BYTES];
+    gradient(frames[0], 0);
+    gradient(frames[1], GifClip::PIXELS);
+
+    GifClip clip;
+    clip.beginEncode(false);
+    TEST_ASSERT_TRUE(clip.addFrame(frames[0], 10));
+    TEST_ASSERT_FALSE(clip.addFrame(frames[1], 10));
+    TEST_ASSERT_TRUE(clip.paletteOverflowed());
+
+    clip.beginEncode(true);
+    TEST_ASSERT_FALSE(clip.paletteOverflowed());
+    TEST_ASSERT_TRUE(clip.addFrame(frames[0], 10));
+    TEST_ASSERT_TRUE(clip.addFrame(frames[1], 20));
+    TEST_ASSERT_TRUE(clip.endEncode());
+    TEST_ASSERT_TRUE(clip.save("/rgb.clip"));
+
+    GifClip loaded;
+    TEST_ASSERT_TRUE(loaded.load("/rgb.clip"));
+    const uint16_t delays[2] = {10, 20};
+    assertPlaysBack(loaded, frames, delays, 2);
+}
+
+void test_clip_that_does_not_fit_is_rejected(void)
+{
+    static uint8_t canvas[CANVAS_BYTES];
+    GifClip clip;
+    clip.beginEncode(true);
+    bool added = true;
+    for (uint16_t i = 0; added && i < 1000; ++i)
+    {
+        gradient(canvas, i);
+        added = clip.addFrame(canvas, 10);
+    }
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_FALSE(clip.paletteOverflowed());
+}
+
+void test_load_rejects_other_files(void)
+{
+    File file = LittleFS.open("/other.clip", FILE_WRITE);
+    const uint8_t header[16] = {'W', 'C', 'L', 'P', 99, ClockDisplayHAL::WIDTH, ClockDisplayHAL::HEIGHT, 0, 1, 0, 1, 0};
+    file.write(header, sizeof(header));
+    file.close();
+
+    GifClip clip;
+    TEST_ASSERT_FALSE(clip.load("/other.clip"));
+    TEST_ASSERT_FALSE(clip.isValid());
+    TEST_ASSERT_FALSE(clip.load("/missing.clip"));
+    TEST_ASSERT_FALSE(clip.save("/invalid.clip"));
+}
+
+void test_load_rejects_damaged_clips(void)
+{
+    saveTwoFrameClip("/damaged.clip");
+    const std::vector<uint8_t> good = readFile("/damaged.clip");
+    // Header, two palette entries, key frame, then delay, type, count, index, pixel
+    const size_t keyFrame = 12 + 2 * 3;
+    const size_t delta = keyFrame + 3 + GifClip::PIXELS;
+    TEST_ASSERT_EQUAL_size_t(delta + 6, good.size());
+
+    std::vector<std::vector<uint8_t>> damaged;
+    damaged.push_back(std::vector<uint8_t>(good.begin(), good.end() - 1)); // truncated delta
+    damaged.push_back(std::vector<uint8_t>(good.begin(), good.begin() + delta)); // missing frame
+    damaged.push_back(good);
+    damaged.back().push_back(0); // trailing bytes
+    damaged.push_back(good);
+    damaged.back()[keyFrame + 3] = 2; // palette index past the palette
+    damaged.push_back(good);
+    damaged.back()[delta + 4] = GifClip::PIXELS; // LED index past the display
+    damaged.push_back(good);
+    damaged.back()[delta + 3] = 50; // more changed pixels than stored
+    damaged.push_back(good);
+    damaged.back()[keyFrame + 2] = 1; // first frame a delta
+    damaged.push_back(good);
+    damaged.back()[delta + 2] = 7; // unknown frame type
+
+    GifClip clip;
+    TEST_ASSERT_TRUE(clip.load("/damaged.clip"));
+    for (size_t i = 0; i < damaged.size(); ++i)
+    {
+        writeFile("/damaged.clip", damaged[i]);
+        TEST_ASSERT_FALSE(clip.load("/damaged.clip"));
+        TEST_ASSERT_FALSE(clip.isValid());
+    }
+}
+
+void test_save_replaces_the_clip_whole(void)
+{
+    writeFile("/replaced.clip", std::vector<uint8_t>(4000, 0xEE));
+    saveTwoFrameClip("/replaced.clip");
+    GifClip clip;
+    TEST_ASSERT_TRUE(clip.load("/replaced.clip"));
+    TEST_ASSERT_EQUAL_UINT16(2, clip.getFrameCount());
+    TEST_ASSERT_FALSE(LittleFS.exists("/replaced.clip.tmp"));
+}
+
+int main(int argc, char **argv)
+{
+    TEST_ASSERT_NOT_NULL(mkdtemp(flashRoot));
+    Simulator::setFlashRoot(flashRoot);
+    LittleFS.begin(true);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_palette_clip_round_trip);
+    RUN_TEST(test_sparse_change_is_a_delta_frame);
+    RUN_TEST(test_palette_overflow_needs_rgb);
+    RUN_TEST(test_clip_that_does_not_fit_is_rejected);
+    RUN_TEST(test_load_rejects_other_files);
+    RUN_TEST(test_load_rejects_damaged_clips);
+    RUN_TEST(test_save_replaces_the_clip_whole);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <thread>
+#include "SpscQueue.h"
+
+// SpscQueue capacity, ordering across index wrap-around, and one producer
+// thread against one consumer thread
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_empty_queue_pops_nothing(void)
+{
+    SpscQueue<int, 4> queue;
+    int item = -1;
+    TEST_ASSERT_FALSE(queue.pop(item));
+    TEST_ASSERT_EQUAL_INT(-1, item);
+}
+
+void test_holds_exactly_its_capacity(void)
+{
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_FALSE(queue.push(4));
+
+    int item;
+    TEST_ASSERT_TRUE(queue.pop(item));
+    TEST_ASSERT_EQUAL_INT(0, item);
+    TEST_ASSERT_TRUE(queue.push(4));
+    TEST_ASSERT_FALSE(queue.push(5));
+}
+
+void test_first_in_first_out_across_wrap_around(void)
+{
+    SpscQueue<uint32_t, 8> queue;
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    // Uneven batches so head and tail land on every slot
+    for (int round = 0; round < 1000; ++round)
+    {
+        for (int i = 0; i < 1 + round % 8; ++i)
+        {
+            TEST_ASSERT_TRUE(queue.push(next++));
+        }
+        uint32_t item;
+        while (queue.pop(item))
+        {
+            TEST_ASSERT_EQUAL_UINT32(expected++, item);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(next, expected);
+}
+
+void test_producer_and_consumer_threads(void)
+{
+    static SpscQueue<uint32_t, 16> queue;
+    const uint32_t count = 200000;
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            while (!queue.push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < count)
+    {
+        uint32_t item;
+        if (!queue.pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && item == expected;
+        expected++;
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    uint32_t item;
+    TEST_ASSERT_FALSE(queue.pop(item));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_queue_pops_nothing);
+    RUN_TEST(test_holds_exactly_its_capacity);
+    RUN_TEST(test_first_in_first_out_across_wrap_around);
+    RUN_TEST(test_producer_and_consumer_threads);
+    return UNITY_END();
+}
@@ -11,6 +11,10 @@ GIF_PATH="$BASE_PATH/heart_art_small.gif"
 WORKING_DIRECTORY="$BASE_PATH/src/wordclock"
 PYTHON_PATH="/usr/bin/python3"
 
+# Build the native rendering core; without it the clock draws in Python
+echo "Building libwordclock.so"
+make -C "$BASE_PATH/native" || echo "Native build failed, the clock will draw in Python"
+
 # Check if the service already exists
 if [ -f "$SERVICE_PATH" ]; then
     echo "Service $SERVICE_NAME already exists. Removing the old service."
@@ -0,0 +1,37 @@
+#include "Adafruit_NeoPixel.h"
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t pin, neoPixelType type)
+    : numLEDs(n), pixels((uint8_t *)calloc(n, 3))
+{
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel()
+{
+    free(pixels);
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c)
+{
+    if (n >= numLEDs)
+    {
+        return;
+    }
+    uint8_t *p = &pixels[n * 3];
+    p[0] = c >> 8;
+    p[1] = c >> 16;
+    p[2] = c;
+}
+
+void Adafruit_NeoPixel::fill(uint32_t c, uint16_t first, uint16_t count)
+{
+    uint16_t end = (count == 0 || first + count > numLEDs) ? numLEDs : first + count;
+    for (uint16_t i = first; i < end; i++)
+    {
+        setPixelColor(i, c);
+    }
+}
+
+void Adafruit_NeoPixel::clear()
+{
+    memset(pixels, 0, numLEDs * 3);
+}
@@ -0,0 +1,41 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// The slice of the Arduino core the shared rendering code needs, for the
+// Raspberry Pi library. millis() is the real monotonic clock here.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// Log lines go to stderr, next to the Python service's own output
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud) {}
+    size_t print(const char *value) { return fputs(value, stderr); }
+    size_t print(long value) { return fprintf(stderr, "%ld", value); }
+    size_t print(unsigned long value) { return fprintf(stderr, "%lu", value); }
+    size_t print(int value) { return print((long)value); }
+    size_t print(unsigned int value) { return print((unsigned long)value); }
+    template <typename T>
+    size_t println(const T &value) { return print(value) + println(); }
+    size_t println() { return fputs("\n", stderr); }
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Settings the shared sources read from the sketch's config.h
+#define USE_SERIAL 1
+
+#endif
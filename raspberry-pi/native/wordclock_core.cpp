@@ -0,0 +1,167 @@
+#include "ClockDisplayHAL.h"
+#include "DisplayEffects.h"
+#include "WordLayout.h"
+
+// C interface to the ESP32 rendering code for the Raspberry Pi port, loaded
+// with ctypes by src/wordclock/native_core.py. Drawing, effects, gamma and
+// brightness all run here; Python only sends the finished frame to the strip.
+// The HAL's compositing layers are not exposed: they serve the ESP's phrase
+// transitions, which the Pi clock does not have.
+
+struct WordClockCore
+{
+    ClockDisplayHAL hal;
+    DisplayEffects effects;
+    Animation *active;
+
+    WordClockCore(uint8_t brightness)
+        : hal(0, brightness, LedBackend::EXTERNAL), effects(&hal), active(nullptr)
+    {
+    }
+};
+
+// Built with -fvisibility=hidden; only this interface is exported
+#pragma GCC visibility push(default)
+extern "C"
+{
+    WordClockCore *wc_create(uint8_t brightness)
+    {
+        WordClockCore *core = new WordClockCore(brightness);
+        core->hal.setup();
+        // Frames are only pushed when they change, too rarely for dithering to settle
+        core->hal.setDithering(false);
+        return core;
+    }
+
+    void wc_destroy(WordClockCore *core)
+    {
+        delete core;
+    }
+
+    uint16_t wc_num_leds()
+    {
+        return ClockDisplayHAL::NUM_LEDS;
+    }
+
+    uint8_t wc_word_count()
+    {
+        return WORD_COUNT;
+    }
+
+    // Lets the binding check its word table against this build; false past the last word
+    bool wc_word_span(uint8_t word, uint8_t *start, uint8_t *end)
+    {
+        if (word >= WORD_COUNT)
+        {
+            return false;
+        }
+        *start = WORD_SPANS[word].start;
+        *end = WORD_SPANS[word].end;
+        return true;
+    }
+
+    void wc_set_brightness(WordClockCore *core, uint8_t brightness)
+    {
+        core->hal.setBrightness(brightness);
+    }
+
+    void wc_clear(WordClockCore *core)
+    {
+        core->hal.clearPixels(false);
+    }
+
+    void wc_display_word(WordClockCore *core, uint8_t word, uint32_t color)
+    {
+        if (word < WORD_COUNT)
+        {
+            core->hal.displayWord(static_cast<WordId>(word), color);
+        }
+    }
+
+    void wc_set_pixel(WordClockCore *core, uint8_t x, uint8_t y, uint32_t color)
+    {
+        core->hal.setPixel(x, y, color);
+    }
+
+    // Packed RGB888, row-major from the top left; false unless size is a whole frame
+    bool wc_blit_frame(WordClockCore *core, const uint8_t *rgb, size_t size)
+    {
+        if (size != ClockDisplayHAL::NUM_LEDS * 3)
+        {
+            return false;
+        }
+        core->hal.blitFrame(rgb);
+        return true;
+    }
+
+    // True when the frame changed and wc_output() holds a new one to send
+    bool wc_show(WordClockCore *core)
+    {
+        uint32_t sent = core->hal.getFramesSent();
+        core->hal.show();
+        return core->hal.getFramesSent() != sent;
+    }
+
+    const uint8_t *wc_output(WordClockCore *core)
+    {
+        return core->hal.getOutput();
+    }
+
+    uint32_t wc_estimated_current_ma(WordClockCore *core)
+    {
+        return core->hal.getEstimatedCurrentMa();
+    }
+
+    // The clock millis(), wc_tick() and wc_next_deadline() run on
+    unsigned long wc_millis()
+    {
+        return millis();
+    }
+
+    // Effects 0..count-1 follow EffectType; count itself is RANDOM
+    uint8_t wc_effect_count()
+    {
+        return static_cast<uint8_t>(EffectType::RANDOM);
+    }
+
+    const char *wc_effect_name(uint8_t effect)
+    {
+        return DisplayEffects::name(static_cast<EffectType>(effect));
+    }
+
+    void wc_effect_begin(WordClockCore *core, uint8_t effect, unsigned long durationMs, uint32_t color)
+    {
+        if (effect > static_cast<uint8_t>(EffectType::RANDOM))
+        {
+            effect = static_cast<uint8_t>(EffectType::RANDOM);
+        }
+        core->effects.begin(static_cast<EffectType>(effect), durationMs, color);
+        core->active = &core->effects;
+    }
+
+    // Advances the running animation. Returns false once it has finished;
+    // pushed is set when it drew a frame that wc_output() now holds.
+    bool wc_tick(WordClockCore *core, unsigned long now, bool *pushed)
+    {
+        *pushed = false;
+        if (core->active == nullptr)
+        {
+            return false;
+        }
+        uint32_t sent = core->hal.getFramesSent();
+        core->active->tick(now);
+        *pushed = core->hal.getFramesSent() != sent;
+        if (core->active->done())
+        {
+            core->active = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    unsigned long wc_next_deadline(WordClockCore *core)
+    {
+        return core->active != nullptr ? core->active->nextDeadline() : millis();
+    }
+}
+#pragma GCC visibility pop
@@ -1,64 +1,71 @@
 import board
 import neopixel
+from neopixel_write import neopixel_write
+from native_core import NativeCore
+import layout
 
+GAMMA = 2.2
 
 
+def build_output_lut(brightness):
+    """Gamma curve and global brightness folded into one table, so show() costs
+    one lookup per channel instead of a float multiply on every write. Non-zero
+    values stay at least 1, or at low brightness dim channels would vanish and
+    shift the hue, e.g. brown (165, 42, 42) to pure red."""
+    floor = 1 if brightness > 0 else 0
+    return [max(floor, round(255 * (value / 255) ** GAMMA * brightness)) if value else 0 for value in range(256)]
+
 
 """
 Clock Display Hardware Abstraction Layer
 
-Display letters and indexes
-131 ITLISASTHPMA 120
-108 ACFIFTEENDCO 119
-107 TWENTYFIVEXW 096
-084 THIRTYXTENXW 095
-083 MINUTESETOUR 072
-060 PASTORUFOURT 071
-059 SEVENXTWELVE 048
-036 NINEFIVECTWO 047
-035 EIGHTFELEVEN 024
-012 SIXTHREEONEG 023
-011 TENSEZOCLOCK 000
+The grid and word positions come from layout.py, generated from
+layouts/*.json by tools/generate_layout.py along with the C++ tables.
 """
 class ClockDisplayHAL:
-    WIDTH = 12
-    HEIGHT = 11
+    WIDTH = layout.WIDTH
+    HEIGHT = layout.HEIGHT
     NUM_LEDS = WIDTH * HEIGHT
 
-    WORDS_TO_LEDS = {
-        "HOUR_1": (20, 22),
-        "HOUR_2": (45, 47),
-        "HOUR_3": (15, 19),
-        "HOUR_4": (67, 70),
-        "HOUR_5": (40, 43),
-        "HOUR_6": (12, 14),
-        "HOUR_7": (55, 59),
-        "HOUR_8": (31, 35),
-        "HOUR_9": (36, 39),
-        "HOUR_10": (9, 11),
-        "HOUR_11": (24, 29),
-        "HOUR_12": (48, 53),
-        "OCLOCK": (0, 5),
-        "PAST": (60, 63),
-        "TO": (63, 64),
-        "MINUTES": (77, 83),
-        "THIRTY": (84, 89),
-        "TWENTY": (102, 107),
-        "TWENTYFIVE": (98, 107),
-        "FIVE": (98, 101),
-        "TEN": (91, 93),
-        "FIFTEEN": (110, 116),
-        "IS": (127, 128),
-        "IT": (130, 131),
-    }
+    WORDS_TO_LEDS = layout.WORDS_TO_LEDS
+
+    # Word order matches the C++ WordId enum
+    WORD_IDS = {word: index for index, word in enumerate(WORDS_TO_LEDS)}
 
     def __init__(self, board_pin, brightness):
-        self.pixels = neopixel.NeoPixel(getattr(board, board_pin), self.NUM_LEDS, brightness=brightness, auto_write=False)
+        # Brightness is applied through the output table; at 1.0 the library doesn't scale
+        self.pixels = neopixel.NeoPixel(getattr(board, board_pin), self.NUM_LEDS, brightness=1.0, auto_write=False)
+        self.frame = [(0, 0, 0)] * self.NUM_LEDS
+        self.core = self.load_core(brightness)
+        self.set_brightness(brightness)
+
+    @staticmethod
+    def load_core(brightness):
+        """The native renderer when libwordclock.so is built, otherwise None and
+        frames are drawn in Python."""
+        try:
+            core = NativeCore(brightness)
+        except OSError as error:
+            print(f"Native core unavailable ({error}), drawing in Python")
+            return None
+        if core.word_spans() != list(ClockDisplayHAL.WORDS_TO_LEDS.values()):
+            raise RuntimeError("libwordclock.so was built from a different word layout; rebuild it")
+        return core
+
+    def set_brightness(self, brightness):
+        self.brightness = brightness
+        if self.core:
+            self.core.set_brightness(brightness)
+        else:
+            self.output_lut = build_output_lut(brightness)
 
     def display_word(self, word, color):
+        if self.core:
+            self.core.display_word(ClockDisplayHAL.WORD_IDS[word], color)
+            return
         start, end = ClockDisplayHAL.WORDS_TO_LEDS[word]
         for i in range(start, end + 1):
-            self.pixels[i] = color
+            self.frame[i] = color
 
     def cartesian_to_word_clock_led_strip_index(self, x, y):
         if y % 2 == 0:
@@ -68,17 +75,46 @@ class ClockDisplayHAL:
             row_index = ClockDisplayHAL.NUM_LEDS - ((y + 1) * ClockDisplayHAL.WIDTH)
             index = row_index + x
         if index < 0 or index >= ClockDisplayHAL.NUM_LEDS:
-            raise ValueError(f"Invalid x={x}, y={y}. Hardware only supports x=0-11, y=0-10")
+            raise ValueError(f"Invalid x={x}, y={y}. Hardware only supports x=0-{ClockDisplayHAL.WIDTH - 1}, y=0-{ClockDisplayHAL.HEIGHT - 1}")
         return index
 
     def set_pixel(self, x, y, color, width=12):
         index = self.cartesian_to_word_clock_led_strip_index(x, y)
-        self.pixels[index] = color
+        if self.core:
+            self.core.set_pixel(x, y, color)
+        else:
+            self.frame[index] = color
+
+    def blit_frame(self, rgb):
+        """Draws a whole WIDTH x HEIGHT frame of packed RGB888 bytes, row-major from the top left."""
+        if self.core:
+            self.core.blit_frame(rgb)
+            return
+        for y in range(self.HEIGHT):
+            for x in range(self.WIDTH):
+                offset = (y * self.WIDTH + x) * 3
+                self.set_pixel(x, y, tuple(rgb[offset:offset + 3]))
 
     def clear_pixels(self, show=True):
-        self.pixels.fill((0, 0, 0))
+        if self.core:
+            self.core.clear()
+        else:
+            self.frame = [(0, 0, 0)] * self.NUM_LEDS
         if show:
-            self.pixels.show()
+            self.show()
 
     def show(self):
+        if self.core:
+            # Skipped when nothing changed
+            if self.core.show():
+                self.write_output()
+            return
+
+        lut = self.output_lut
+        for i, (r, g, b) in enumerate(self.frame):
+            self.pixels[i] = (lut[r], lut[g], lut[b])
         self.pixels.show()
+
+    def write_output(self):
+        """Sends the native core's last frame to the strip as one contiguous GRB buffer."""
+        neopixel_write(self.pixels.pin, self.core.output())
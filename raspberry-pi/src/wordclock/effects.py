@@ -0,0 +1,65 @@
+import time
+
+# Frame rate the Pi Zero should sustain while leaving most of its one core free
+TARGET_FPS = 60
+
+
+def display_effect(clock_display_hal, effect=None, display_effect_duration=4):
+    """Plays a DisplayEffects effect from the native core (random when effect is
+    None) for display_effect_duration seconds, at the frame rate the effect asks
+    for. Returns the frames shown, the achieved FPS and the share of one CPU
+    core the playback used.
+    """
+    core = clock_display_hal.core
+    core.begin_effect(effect, int(display_effect_duration * 1000))
+    start_time = time.monotonic()
+    start_cpu = time.process_time()
+    shown = 0
+
+    while True:
+        running, pushed = core.tick(core.millis())
+        if not running:
+            break
+        if pushed:
+            clock_display_hal.write_output()
+            shown += 1
+        remaining = core.next_deadline() - core.millis()
+        if remaining > 0:
+            time.sleep(remaining / 1000)
+
+    elapsed = time.monotonic() - start_time
+    return {
+        "shown": shown,
+        "fps": shown / elapsed,
+        "cpu_percent": 100 * (time.process_time() - start_cpu) / elapsed,
+    }
+
+
+def benchmark_effects(clock_display_hal, frames=600):
+    """Renders and sends frames of every effect back to back, ignoring their
+    frame delays, to measure what the hardware can sustain rather than what the
+    effects ask for. Per effect, reports the unpaced FPS, the CPU time per
+    frame and the share of one core that TARGET_FPS would take.
+    """
+    core = clock_display_hal.core
+    results = {}
+    for effect in core.effects:
+        # Run the effect on its own deadlines instead of the clock, so every tick draws
+        core.begin_effect(effect, 2 ** 31)
+        start_time = time.monotonic()
+        start_cpu = time.process_time()
+        shown = 0
+        while shown < frames:
+            _, pushed = core.tick(core.next_deadline())
+            if pushed:
+                clock_display_hal.write_output()
+                shown += 1
+        elapsed = time.monotonic() - start_time
+        cpu_ms = 1000 * (time.process_time() - start_cpu) / frames
+        results[effect] = {
+            "fps": round(frames / elapsed, 1),
+            "cpu_ms_per_frame": round(cpu_ms, 3),
+            "cpu_percent_at_target": round(cpu_ms * TARGET_FPS / 10, 1),
+        }
+    clock_display_hal.clear_pixels()
+    return results
@@ -1,37 +1,172 @@
-from PIL import Image
+from PIL import Image, ImageSequence
+import hashlib
+import os
+import struct
 import time
 from clock_display_hal import ClockDisplayHAL
 
+# Browsers show frames with tiny or missing delays at 10 FPS; so do we
+MIN_FRAME_DELAY = 0.02
+DEFAULT_FRAME_DELAY = 0.1
 
-def update_led_pixels(gif_pixels, new_size, clock_display_hal):
-    for y in range(new_size[1]):
-        for x in range(new_size[0]):
-            r, g, b = gif_pixels[x, y][:3]
-            clock_display_hal.set_pixel(x, y, (r, g, b))
+# Decoded frames survive restarts here, one file per GIF path and background
+CACHE_DIR = os.environ.get("WORDCLOCK_CACHE_DIR", os.path.expanduser("~/.cache/wordclock"))
+# "WCGF", version, width, height, frame count, decode time in microseconds,
+# the GIF's mtime in nanoseconds; then per frame its delay in milliseconds and
+# WIDTH * HEIGHT * 3 bytes of RGB
+CACHE_MAGIC = b"WCGF"
+CACHE_VERSION = 1
+CACHE_HEADER = struct.Struct("<4sBBBHIQ")
+CACHE_DELAY = struct.Struct("<H")
 
 
-def display_gif(gif_path, clock_display_hal, display_gif_duration=4, background_color=(0, 0, 0)):
-    img = Image.open(gif_path)
+class GifFrames:
+    """A GIF decoded and resized to the display, as packed RGB888 frames."""
+
+    def __init__(self, frames, delays, decode_time):
+        self.frames = frames
+        self.delays = delays
+        self.decode_time = decode_time
+
+    @property
+    def size_bytes(self):
+        return sum(len(frame) for frame in self.frames)
+
+
+# Decoded GIFs by (path, mtime, background); a changed file gets a new key
+_loaded = {}
+
+
+def flatten(frame, background_color):
+    """Packed RGB888 bytes of an RGBA frame; any pixel that isn't fully
+    transparent is drawn opaque, the rest take the background colour."""
+    opaque = frame.getchannel("A").point(lambda a: 255 if a > 0 else 0)
+    flat = Image.new("RGB", frame.size, background_color)
+    flat.paste(frame.convert("RGB"), mask=opaque)
+    return flat.tobytes()
+
+
+def frame_delay(img):
+    delay = img.info.get("duration", 0) / 1000.0
+    return delay if delay >= MIN_FRAME_DELAY else DEFAULT_FRAME_DELAY
+
+
+def decode_gif(gif_path, background_color):
+    start = time.monotonic()
     new_size = (ClockDisplayHAL.WIDTH, ClockDisplayHAL.HEIGHT)
-    start_time = time.time()
-
-    while time.time() < start_time + display_gif_duration:
-        try:
-            frame = img.convert("RGBA")
-            frame = frame.resize(new_size)
-            gif_pixels = frame.load()
-
-            for y in range(new_size[1]):
-                for x in range(new_size[0]):
-                    r, g, b, a = gif_pixels[x, y]
-                    if a > 0:
-                        clock_display_hal.set_pixel(x, y, (r, g, b))
-                    else:
-                        clock_display_hal.set_pixel(x, y, background_color)
+    frames, delays = [], []
+    with Image.open(gif_path) as img:
+        for frame in ImageSequence.Iterator(img):
+            delays.append(frame_delay(frame))
+            frames.append(flatten(frame.convert("RGBA").resize(new_size), background_color))
+    return GifFrames(frames, delays, time.monotonic() - start)
+
+
+def read_cache(cache_path, mtime_ns):
+    try:
+        with open(cache_path, "rb") as file:
+            data = file.read()
+        magic, version, width, height, count, decode_us, cached_mtime_ns = CACHE_HEADER.unpack_from(data)
+    except (OSError, struct.error):
+        return None
+    frame_size = ClockDisplayHAL.WIDTH * ClockDisplayHAL.HEIGHT * 3
+    record_size = CACHE_DELAY.size + frame_size
+    if (magic != CACHE_MAGIC or version != CACHE_VERSION or (width, height) != (ClockDisplayHAL.WIDTH, ClockDisplayHAL.HEIGHT)
+            or cached_mtime_ns != mtime_ns or len(data) != CACHE_HEADER.size + count * record_size):
+        return None
+
+    frames, delays = [], []
+    for offset in range(CACHE_HEADER.size, len(data), record_size):
+        delays.append(CACHE_DELAY.unpack_from(data, offset)[0] / 1000.0)
+        frames.append(data[offset + CACHE_DELAY.size:offset + record_size])
+    return GifFrames(frames, delays, decode_us / 1e6)
 
+
+def write_cache(cache_path, mtime_ns, gif_frames):
+    records = [CACHE_DELAY.pack(min(round(delay * 1000), 0xFFFF)) + frame for frame, delay in zip(gif_frames.frames, gif_frames.delays)]
+    header = CACHE_HEADER.pack(CACHE_MAGIC, CACHE_VERSION, ClockDisplayHAL.WIDTH, ClockDisplayHAL.HEIGHT,
+                               len(records), round(gif_frames.decode_time * 1e6), mtime_ns)
+    try:
+        os.makedirs(CACHE_DIR, exist_ok=True)
+        # Written aside and renamed, so a crash never leaves a torn file behind
+        with open(cache_path + ".tmp", "wb") as file:
+            file.write(header + b"".join(records))
+        os.replace(cache_path + ".tmp", cache_path)
+    except OSError as error:
+        print(f"Cannot cache GIF frames in {CACHE_DIR}: {error}")
+
+
+def load_gif(gif_path, background_color=(0, 0, 0)):
+    """Returns (GifFrames, source), decoding the GIF at most once per version of
+    the file: later calls come from memory ("memory"), and after a restart from
+    the disk cache ("disk"). Only a new or changed file is "decoded".
+    """
+    path = os.path.abspath(gif_path)
+    mtime_ns = os.stat(path).st_mtime_ns
+    key = (path, mtime_ns, tuple(background_color))
+    if key in _loaded:
+        return _loaded[key], "memory"
+
+    # A changed GIF overwrites its old cache file instead of adding another
+    name = hashlib.sha1(repr((path, tuple(background_color))).encode()).hexdigest()
+    cache_path = os.path.join(CACHE_DIR, name + ".frames")
+    gif_frames, source = read_cache(cache_path, mtime_ns), "disk"
+    if gif_frames is None:
+        gif_frames, source = decode_gif(path, background_color), "decoded"
+        write_cache(cache_path, mtime_ns, gif_frames)
+
+    # Older versions of the same file are never asked for again
+    for stale in [loaded for loaded in _loaded if loaded[0] == path]:
+        del _loaded[stale]
+    _loaded[key] = gif_frames
+    return gif_frames, source
+
+
+def display_gif(gif_path, clock_display_hal, display_gif_duration=4, background_color=(0, 0, 0)):
+    """Plays a GIF for display_gif_duration seconds, honoring each frame's delay.
+
+    Frames come decoded and resized from load_gif(), so each one is a single
+    blit. Each deadline is the previous one plus the frame's delay, so time
+    spent drawing doesn't accumulate into drift. A frame whose delay has
+    already elapsed by the time it is reached is skipped. Returns pacing
+    stats, plus the cache footprint and the decode time the cache saved.
+    """
+    load_start = time.monotonic()
+    gif_frames, source = load_gif(gif_path, background_color)
+    load_time = time.monotonic() - load_start
+    stats = {
+        "shown": 0, "dropped": 0, "max_jitter": 0.0, "total_jitter": 0.0,
+        "cache": source,
+        "frame_bytes": gif_frames.size_bytes,
+        "decode_time_saved": 0.0 if source == "decoded" else max(0.0, gif_frames.decode_time - load_time),
+    }
+
+    start_time = time.monotonic()
+    end_time = start_time + display_gif_duration
+    deadline = start_time
+    index = 0
+
+    while True:
+        now = time.monotonic()
+        if now >= end_time:
+            break
+
+        delay = gif_frames.delays[index]
+        if now >= deadline + delay:
+            stats["dropped"] += 1
+        else:
+            clock_display_hal.blit_frame(gif_frames.frames[index])
             clock_display_hal.show()
-            time.sleep(0.1)
-            img.seek(img.tell() + 1)
+            jitter = max(0.0, now - deadline)
+            stats["shown"] += 1
+            stats["total_jitter"] += jitter
+            stats["max_jitter"] = max(stats["max_jitter"], jitter)
+
+        deadline += delay
+        index = (index + 1) % len(gif_frames.frames)
+
+        remaining = min(deadline, end_time) - time.monotonic()
+        if remaining > 0:
+            time.sleep(remaining)
 
-        except EOFError:
-            img.seek(0)
+    return stats
@@ -0,0 +1,202 @@
+# Generated by tools/generate_layout.py from layouts/english.json; do not edit.
+
+NAME = 'english'
+WIDTH = 12
+HEIGHT = 11
+
+GRID = [
+    'ITLISASTHPMA',
+    'ACFIFTEENDCO',
+    'TWENTYFIVEXW',
+    'THIRTYXTENXW',
+    'MINUTESETOUR',
+    'PASTORUFOURT',
+    'SEVENXTWELVE',
+    'NINEFIVECTWO',
+    'EIGHTFELEVEN',
+    'SIXTHREEONEG',
+    'TENSEZOCLOCK',
+]
+
+# Inclusive LED ranges, in the order of the C++ WordId enum
+WORDS_TO_LEDS = {
+    'HOUR_1': (20, 22),
+    'HOUR_2': (45, 47),
+    'HOUR_3': (15, 19),
+    'HOUR_4': (67, 70),
+    'HOUR_5': (40, 43),
+    'HOUR_6': (12, 14),
+    'HOUR_7': (55, 59),
+    'HOUR_8': (31, 35),
+    'HOUR_9': (36, 39),
+    'HOUR_10': (9, 11),
+    'HOUR_11': (24, 29),
+    'HOUR_12': (48, 53),
+    'OCLOCK': (0, 5),
+    'PAST': (60, 63),
+    'TO': (63, 64),
+    'MINUTES': (77, 83),
+    'THIRTY': (84, 89),
+    'TWENTY': (102, 107),
+    'TWENTYFIVE': (98, 107),
+    'FIVE': (98, 101),
+    'TEN': (91, 93),
+    'FIFTEEN': (110, 116),
+    'IS': (127, 128),
+    'IT': (130, 131),
+    'DOT_1': (123, 123),
+    'DOT_2': (122, 122),
+    'DOT_3': (121, 121),
+    'DOT_4': (120, 120),
+}
+
+# Words of every 5-minute slot of a 12-hour day, index hour % 12 * 12 + minute // 5
+PHRASES = [
+    ('IT', 'IS', 'OCLOCK', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_12',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_12',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_1',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_1',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_1',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_1',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_1',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_1',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_1',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_2',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_2',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_2',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_2',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_2',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_2',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_2',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_3',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_3',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_3',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_3',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_3',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_3',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_3',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_4',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_4',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_4',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_4',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_4',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_4',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_4',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_5',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_5',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_5',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_5',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_5',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_5',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_5',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_6',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_6',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_6',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_6',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_6',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_6',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_6',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_7',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_7',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_7',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_7',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_7',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_7',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_7',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_8',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_8',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_8',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_8',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_8',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_8',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_8',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_9',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_9',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_9',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_9',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_9',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_9',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_9',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_10',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_10',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_10',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_10',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_10',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_10',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_10',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_11',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_11',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_11',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_11',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_11',),
+    ('IT', 'IS', 'OCLOCK', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIVE', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TEN', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'FIFTEEN', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTY', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'TWENTYFIVE', 'HOUR_11',),
+    ('IT', 'IS', 'PAST', 'MINUTES', 'THIRTY', 'HOUR_11',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTYFIVE', 'HOUR_12',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TWENTY', 'HOUR_12',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIFTEEN', 'HOUR_12',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'TEN', 'HOUR_12',),
+    ('IT', 'IS', 'TO', 'MINUTES', 'FIVE', 'HOUR_12',),
+]
+
+# Spare letters lit one per minute past the 5-minute slot
+MINUTE_DOTS = ('DOT_1', 'DOT_2', 'DOT_3', 'DOT_4')
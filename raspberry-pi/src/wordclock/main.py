@@ -1,20 +1,61 @@
 import argparse
+import json
+import math
+import os
 import time
 from clock_display_hal import ClockDisplayHAL
 from word_clock import WordClock
+from effects import benchmark_effects
 
 
-# Color definitions
+# The displayed phrase changes every five minutes, the minute dots every minute.
+# Time zones are offset from UTC by whole multiples of five minutes, so epoch
+# boundaries are local ones too.
+PHRASE_PERIOD = 5 * 60
+MINUTE_PERIOD = 60
 
 
-def main(pin, brightness, gif_path):
+def next_phrase_change(now, period=PHRASE_PERIOD):
+    return (math.floor(now / period) + 1) * period
+
+
+def sleep_until(deadline):
+    """Sleeps until the wall-clock time deadline, in seconds since the epoch.
+
+    Uses an absolute CLOCK_REALTIME timerfd where Python has one (3.13+), so an
+    NTP step while asleep doesn't move the wake. Otherwise sleeps the remaining
+    time and re-checks the clock.
+    """
+    if hasattr(os, "timerfd_create"):
+        fd = os.timerfd_create(time.CLOCK_REALTIME)
+        try:
+            os.timerfd_settime(fd, flags=os.TFD_TIMER_ABSTIME, initial=deadline)
+            os.read(fd, 8)
+        finally:
+            os.close(fd)
+        return
+
+    while True:
+        remaining = deadline - time.time()
+        if remaining <= 0:
+            return
+        time.sleep(remaining)
+
+
+def main(pin, brightness, gif_path, benchmark_frames, minute_precision):
     clock_display_hal = ClockDisplayHAL(pin, brightness)
-    word_clock = WordClock(clock_display_hal, gif_path)
+    if benchmark_frames:
+        if not clock_display_hal.core:
+            raise SystemExit("The effects benchmark needs the native core; run make -C native")
+        print(json.dumps(benchmark_effects(clock_display_hal, benchmark_frames)))
+        return
+    word_clock = WordClock(clock_display_hal, gif_path, minute_precision)
+    period = MINUTE_PERIOD if minute_precision else PHRASE_PERIOD
 
     try:
         while True:
             word_clock.display_time()
-            time.sleep(10)
+            sleep_until(next_phrase_change(time.time(), period))
     except KeyboardInterrupt:
         clock_display_hal.clear_pixels()
 
@@ -27,5 +68,9 @@ if __name__ == "__main__":
                         required=False, help="The brightness of the clock display.",
                         default=0.05)
     parser.add_argument("--gif", type=str, required=False, help="The path to the GIF image.")
+    parser.add_argument("--benchmark-effects", type=int, required=False, metavar="FRAMES",
+                        help="Render this many frames of every effect unpaced, print JSON stats and exit.")
+    parser.add_argument("--minute-precision", action="store_true",
+                        help="Light a spare letter for each minute past the 5-minute phrase.")
     args = parser.parse_args()
-    main(args.pin, args.brightness, args.gif)
+    main(args.pin, args.brightness, args.gif, args.benchmark_effects, args.minute_precision)
@@ -0,0 +1,122 @@
+import ctypes
+import os
+
+LIBRARY_PATH = os.environ.get(
+    "WORDCLOCK_CORE_LIB",
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "native", "build", "libwordclock.so"))
+
+
+def pack_color(color):
+    r, g, b = color
+    return (r << 16) | (g << 8) | b
+
+
+class NativeCore:
+    """ctypes binding to libwordclock.so, the ESP32 rendering code built for
+    Linux (see native/Makefile). Frames are drawn and gamma corrected in C++; output() is the finished frame in strip (GRB) order,
+    ready to be written to the LEDs in one go. Raises OSError if the library
+    hasn't been built.
+    """
+
+    def __init__(self, brightness, path=LIBRARY_PATH):
+        lib = ctypes.CDLL(path)
+        lib.wc_create.argtypes = [ctypes.c_uint8]
+        lib.wc_create.restype = ctypes.c_void_p
+        lib.wc_destroy.argtypes = [ctypes.c_void_p]
+        lib.wc_num_leds.restype = ctypes.c_uint16
+        lib.wc_word_count.restype = ctypes.c_uint8
+        lib.wc_word_span.argtypes = [ctypes.c_uint8, ctypes.POINTER(ctypes.c_uint8), ctypes.POINTER(ctypes.c_uint8)]
+        lib.wc_word_span.restype = ctypes.c_bool
+        lib.wc_set_brightness.argtypes = [ctypes.c_void_p, ctypes.c_uint8]
+        lib.wc_clear.argtypes = [ctypes.c_void_p]
+        lib.wc_display_word.argtypes = [ctypes.c_void_p, ctypes.c_uint8, ctypes.c_uint32]
+        lib.wc_set_pixel.argtypes = [ctypes.c_void_p, ctypes.c_uint8, ctypes.c_uint8, ctypes.c_uint32]
+        lib.wc_blit_frame.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t]
+        lib.wc_blit_frame.restype = ctypes.c_bool
+        lib.wc_show.argtypes = [ctypes.c_void_p]
+        lib.wc_show.restype = ctypes.c_bool
+        lib.wc_output.argtypes = [ctypes.c_void_p]
+        lib.wc_output.restype = ctypes.c_void_p
+        lib.wc_estimated_current_ma.argtypes = [ctypes.c_void_p]
+        lib.wc_estimated_current_ma.restype = ctypes.c_uint32
+        lib.wc_millis.restype = ctypes.c_ulong
+        lib.wc_effect_count.restype = ctypes.c_uint8
+        lib.wc_effect_name.argtypes = [ctypes.c_uint8]
+        lib.wc_effect_name.restype = ctypes.c_char_p
+        lib.wc_effect_begin.argtypes = [ctypes.c_void_p, ctypes.c_uint8, ctypes.c_ulong, ctypes.c_uint32]
+        lib.wc_tick.argtypes = [ctypes.c_void_p, ctypes.c_ulong, ctypes.POINTER(ctypes.c_bool)]
+        lib.wc_tick.restype = ctypes.c_bool
+        lib.wc_next_deadline.argtypes = [ctypes.c_void_p]
+        lib.wc_next_deadline.restype = ctypes.c_ulong
+
+        self.lib = lib
+        self.num_leds = lib.wc_num_leds()
+        self.handle = lib.wc_create(self.to_level(brightness))
+        self.effects = [lib.wc_effect_name(i).decode() for i in range(lib.wc_effect_count())]
+        self.pushed = ctypes.c_bool()
+
+    def close(self):
+        if self.handle:
+            self.lib.wc_destroy(self.handle)
+            self.handle = None
+
+    @staticmethod
+    def to_level(brightness):
+        return max(0, min(255, round(brightness * 255)))
+
+    def word_spans(self):
+        """(start, end) of every word, indexed like the C++ WordId enum."""
+        start, end = ctypes.c_uint8(), ctypes.c_uint8()
+        spans = []
+        for word in range(self.lib.wc_word_count()):
+            if not self.lib.wc_word_span(word, ctypes.byref(start), ctypes.byref(end)):
+                break
+            spans.append((start.value, end.value))
+        return spans
+
+    def set_brightness(self, brightness):
+        self.lib.wc_set_brightness(self.handle, self.to_level(brightness))
+
+    def clear(self):
+        self.lib.wc_clear(self.handle)
+
+    def display_word(self, word_id, color):
+        self.lib.wc_display_word(self.handle, word_id, pack_color(color))
+
+    def set_pixel(self, x, y, color):
+        self.lib.wc_set_pixel(self.handle, x, y, pack_color(color))
+
+    def blit_frame(self, rgb):
+        """rgb: packed RGB888 bytes, row-major from the top left."""
+        rgb = bytes(rgb)
+        if len(rgb) != self.num_leds * 3:
+            raise ValueError(f"Frame is {len(rgb)} bytes; expected {self.num_leds * 3}, RGB888 for {self.num_leds} LEDs")
+        self.lib.wc_blit_frame(self.handle, rgb, len(rgb))
+
+    def show(self):
+        """True when the frame changed since the last call and output() should be sent."""
+        return self.lib.wc_show(self.handle)
+
+    def output(self):
+        return ctypes.string_at(self.lib.wc_output(self.handle), self.num_leds * 3)
+
+    def estimated_current_ma(self):
+        return self.lib.wc_estimated_current_ma(self.handle)
+
+    def millis(self):
+        """The millisecond clock tick() and next_deadline() are measured on."""
+        return self.lib.wc_millis()
+
+    def begin_effect(self, effect=None, duration_ms=4000, color=(0, 0, 0)):
+        """Starts one of self.effects by name, or a random one."""
+        index = self.effects.index(effect) if effect else len(self.effects)
+        self.lib.wc_effect_begin(self.handle, index, duration_ms, pack_color(color))
+
+    def tick(self, now):
+        """Advances the running animation. Returns (running, pushed); pushed means
+        it drew a frame and output() should be sent."""
+        running = self.lib.wc_tick(self.handle, now, ctypes.byref(self.pushed))
+        return running, self.pushed.value
+
+    def next_deadline(self):
+        return self.lib.wc_next_deadline(self.handle)
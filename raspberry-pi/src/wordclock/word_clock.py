@@ -1,7 +1,9 @@
 import random
 from datetime import datetime
 from gif import display_gif
+from effects import display_effect
 from clock_display_hal import ClockDisplayHAL
+from layout import PHRASES, MINUTE_DOTS
 
 
 class WordClock:
@@ -15,10 +17,15 @@ class WordClock:
         (255, 255, 255),  # White
         (165, 42, 42),  # Brown
     ]
+    MINUTE_DOT_COLOR = (255, 255, 255)
 
-    def __init__(self, clock_display_hal,gif_path):
+    def __init__(self, clock_display_hal,gif_path, minute_precision=False):
+        """minute_precision lights one spare letter per minute past the 5-minute phrase."""
         self.last_hour = -1
-        self.all_last_highlighted_words = ""
+        self.last_phrase_index = -1
+        self.last_minute_dots = 0
+        self.phrase_colors = []
+        self.minute_precision = minute_precision
         self.clock_display_hal = clock_display_hal
         self.gif_path=gif_path
 
@@ -26,71 +33,42 @@ class WordClock:
         if word in ClockDisplayHAL.WORDS_TO_LEDS:
             self.clock_display_hal.display_word(word, color)
 
-    def get_minutes_word(self, minute):
-        if minute < 5:
-            return "OCLOCK"
-        elif minute < 10:
-            return "FIVE"
-        elif minute < 15:
-            return "TEN"
-        elif minute < 20:
-            return "FIFTEEN"
-        elif minute < 25:
-            return "TWENTY"
-        elif minute < 30:
-            return "TWENTYFIVE"
-        elif minute < 35:
-            return "THIRTY"
-        elif minute < 40:
-            return "TWENTYFIVE"
-        elif minute < 45:
-            return "TWENTY"
-        elif minute < 50:
-            return "FIFTEEN"
-        elif minute < 55:
-            return "TEN"
-        else:
-            return "FIVE"
-
     def get_random_color(self):
         return random.choice(WordClock.COLORS)
 
+    def play_hourly_animation(self):
+        """The GIF if one was given, otherwise a random effect from the native core."""
+        if self.gif_path:
+            stats = display_gif(self.gif_path, self.clock_display_hal)
+            print(f"GIF: {stats['shown']} frames shown, {stats['frame_bytes']} bytes cached, "
+                  f"from {stats['cache']}, {1000 * stats['decode_time_saved']:.0f} ms of decoding saved")
+        elif self.clock_display_hal.core:
+            stats = display_effect(self.clock_display_hal)
+            print(f"Effect: {stats['shown']} frames at {stats['fps']:.1f} FPS, {stats['cpu_percent']:.1f}% CPU")
+
     def display_time(self):
         now = datetime.now()
         hour = now.hour % 12 or 12  # Ensure hour is 1-12
         minute = now.minute
         self.clock_display_hal.clear_pixels(show=False)
-        if hour != self.last_hour and self.gif_path:
-            if minute == 0:
-                display_gif(self.gif_path,self.clock_display_hal)
-                self.clock_display_hal.clear_pixels(show=False)
-                self.last_hour = hour
-
-        self.highlight_word("IT", self.get_random_color())
-        self.highlight_word("IS", self.get_random_color())
-        all_highlighted_words = "ITIS"
-
-        if minute < 5:
-            self.highlight_word("OCLOCK", self.get_random_color())
-            all_highlighted_words = "OCLOCK"
-        elif minute < 35:
-            self.highlight_word("PAST", self.get_random_color())
-            all_highlighted_words += "PAST"
-            self.highlight_word("MINUTES", self.get_random_color())
-            all_highlighted_words += "MINUTES"
-        else:
-            self.highlight_word("TO", self.get_random_color())
-            all_highlighted_words += "TO"
-            self.highlight_word("MINUTES", self.get_random_color())
-            all_highlighted_words += "MINUTES"
-            hour = (hour + 1) % 12 or 12  # Adjust hour for "to" display
+        if hour != self.last_hour and minute == 0:
+            self.play_hourly_animation()
+            self.clock_display_hal.clear_pixels(show=False)
+            self.last_hour = hour
 
-        hour_word = f"HOUR_{hour}"
-        self.highlight_word(self.get_minutes_word(minute), self.get_random_color())
-        all_highlighted_words += self.get_minutes_word(minute)
-        self.highlight_word(hour_word, self.get_random_color())
-        all_highlighted_words += hour_word
+        # The layout's words for this 5-minute slot, hour 0 being twelve. The words
+        # keep their colours until the phrase changes; the minute dots come on in white.
+        phrase_index = now.hour % 12 * 12 + minute // 5
+        minute_dots = minute % 5 if self.minute_precision else 0
+        changed = (phrase_index, minute_dots) != (self.last_phrase_index, self.last_minute_dots)
+        if phrase_index != self.last_phrase_index:
+            self.phrase_colors = [self.get_random_color() for _ in PHRASES[phrase_index]]
+        for word, color in zip(PHRASES[phrase_index], self.phrase_colors):
+            self.highlight_word(word, color)
+        for word in MINUTE_DOTS[:minute_dots]:
+            self.highlight_word(word, self.MINUTE_DOT_COLOR)
 
-        if self.all_last_highlighted_words != all_highlighted_words:
+        if changed:
             self.clock_display_hal.show()
-            self.all_last_highlighted_words = all_highlighted_words
+            self.last_phrase_index = phrase_index
+            self.last_minute_dots = minute_dots
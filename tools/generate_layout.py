@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""Compiles a word clock layout description (layouts/*.json) into the tables
+both ports build against:
+
+  esp/wordclock/src/WordLayoutTables.h      constexpr C++ tables, included by WordLayout.h
+  raspberry-pi/src/wordclock/layout.py      the same data for Python
+
+A layout gives the letter grid, each word as (row, column, letters), named
+lists of the twelve hour words, the words of each 5-minute slot, and four
+spare letters that count the minutes past the slot. A slot refers to the
+hour with {hour} or {hour+1}, optionally from another hour list as
+{hour:full}. Everything is checked here, so a broken layout fails the build
+instead of lighting the wrong letters.
+
+  python3 tools/generate_layout.py layouts/german.json
+  python3 tools/generate_layout.py --check layouts/english.json
+  python3 tools/generate_layout.py --cpp-output build/WordLayoutTables.h layouts/german.json
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+CPP_OUTPUT = os.path.join(ROOT, "esp", "wordclock", "src", "WordLayoutTables.h")
+PYTHON_OUTPUT = os.path.join(ROOT, "raspberry-pi", "src", "wordclock", "layout.py")
+
+SLOTS_PER_HOUR = 12
+MINUTE_DOT_COUNT = 4
+HOUR_TOKEN = re.compile(r"^\{hour(\+1)?(?::(\w+))?\}$")
+WORD_NAME = re.compile(r"^[A-Z][A-Z0-9_]*$")
+
+
+class LayoutError(Exception):
+    pass
+
+
+def led_index(layout, row, column):
+    """Strip index of a grid cell; mirrors GRID_TO_LED in WordLayout.h. The
+    strip snakes up from the bottom right."""
+    width, count = layout["width"], layout["width"] * layout["height"]
+    if row % 2 == 0:
+        return count - row * width - (column + 1)
+    return count - (row + 1) * width + column
+
+
+def word_spans(layout):
+    grid = layout["grid"]
+    if len(grid) != layout["height"] or any(len(row) != layout["width"] for row in grid):
+        raise LayoutError(f"grid must be {layout['height']} rows of {layout['width']} letters")
+    if layout["width"] * layout["height"] > 160:
+        raise LayoutError("LedMask holds at most 160 LEDs")
+
+    spans = {}
+    for name, (row, column, letters) in layout["words"].items():
+        if not WORD_NAME.match(name):
+            raise LayoutError(f"{name}: word names must be C++ identifiers in upper case")
+        if grid[row][column:column + len(letters)] != letters:
+            raise LayoutError(f"{name}: row {row} column {column} reads "
+                              f"{grid[row][column:column + len(letters)]!r}, not {letters!r}")
+        ends = (led_index(layout, row, column), led_index(layout, row, column + len(letters) - 1))
+        spans[name] = (min(ends), max(ends))
+    return spans
+
+
+def phrases(layout, spans):
+    """The words of every slot for hours 0-11, hour 0 being twelve."""
+    hour_lists = layout["hours"]
+    for name, words in hour_lists.items():
+        if len(words) != 12 or any(word not in spans for word in words):
+            raise LayoutError(f"hours.{name} must list twelve known words")
+    if len(layout["phrases"]) != SLOTS_PER_HOUR:
+        raise LayoutError(f"phrases must have {SLOTS_PER_HOUR} slots, one per 5 minutes")
+
+    resolved = []
+    for hour in range(12):
+        for slot, template in enumerate(layout["phrases"]):
+            words = []
+            for token in template:
+                match = HOUR_TOKEN.match(token)
+                if match:
+                    hours = hour_lists.get(match.group(2) or "default")
+                    if hours is None:
+                        raise LayoutError(f"slot {slot}: no hour list {match.group(2)!r}")
+                    words.append(hours[(hour + (1 if match.group(1) else 0)) % 12 - 1])
+                elif token in spans:
+                    words.append(token)
+                else:
+                    raise LayoutError(f"slot {slot}: unknown word {token!r}")
+            resolved.append(words)
+    return resolved
+
+
+def minute_dots(layout, spans, resolved):
+    """Words lit one per minute past the slot; they must not be part of any phrase."""
+    dots = layout["minute_dots"]
+    if len(dots) != MINUTE_DOT_COUNT or any(word not in spans for word in dots):
+        raise LayoutError(f"minute_dots must list {MINUTE_DOT_COUNT} known words")
+    phrase_leds = {led for words in resolved for word in words for led in range(spans[word][0], spans[word][1] + 1)}
+    for word in dots:
+        if phrase_leds.intersection(range(spans[word][0], spans[word][1] + 1)):
+            raise LayoutError(f"minute dot {word} shares LEDs with a phrase word")
+    return dots
+
+
+def grid_comment(layout):
+    lines = []
+    for row, letters in enumerate(layout["grid"]):
+        left = led_index(layout, row, 0)
+        right = led_index(layout, row, layout["width"] - 1)
+        lines.append(f"{left:03d} {letters} {right:03d}")
+    return "\n".join(lines)
+
+
+def generate_cpp(layout, source, spans, resolved, dots):
+    names = list(spans)
+    max_words = max(len(words) for words in resolved)
+    out = [
+        f"// Generated by tools/generate_layout.py from {source}; do not edit.",
+        "// Included by WordLayout.h, which declares WordSpan.",
+        "",
+        "/*",
+        "Display letters and LED strip indexes",
+        "",
+        grid_comment(layout),
+        "*/",
+        "",
+        f"#define WORD_LAYOUT_{layout['name'].upper()} 1",
+        "",
+        f"constexpr uint8_t GRID_WIDTH = {layout['width']};",
+        f"constexpr uint8_t GRID_HEIGHT = {layout['height']};",
+        "",
+        "enum class WordId : uint8_t",
+        "{",
+    ]
+    out += [f"    {name}," for name in names]
+    out += [
+        "    COUNT",
+        "};",
+        "",
+        "constexpr uint8_t WORD_COUNT = static_cast<uint8_t>(WordId::COUNT);",
+        "",
+        "// Inclusive LED ranges, indexed by WordId",
+        "inline constexpr WordSpan WORD_SPANS[WORD_COUNT] = {",
+    ]
+    span_lines = [f"{{{start}, {end}}}," for start, end in spans.values()]
+    span_lines[-1] = span_lines[-1].rstrip(",")
+    width = max(len(line) for line in span_lines) + 1
+    out += [f"    {line.ljust(width)}// {name}" for line, name in zip(span_lines, names)]
+    out += [
+        "};",
+        "",
+        "// Words of every 5-minute slot of a 12-hour day, index hour * 12 + minute / 5",
+        f"constexpr uint8_t LAYOUT_PHRASE_MAX_WORDS = {max_words};",
+        f"constexpr uint8_t LAYOUT_PHRASE_COUNT = {len(resolved)};",
+        "",
+        "struct LayoutPhrase",
+        "{",
+        "    WordId words[LAYOUT_PHRASE_MAX_WORDS];",
+        "    uint8_t wordCount;",
+        "};",
+        "",
+        "inline constexpr LayoutPhrase LAYOUT_PHRASES[LAYOUT_PHRASE_COUNT] = {",
+    ]
+    phrase_lines = ["    {{" + ", ".join(f"WordId::{word}" for word in words) + f"}}, {len(words)}}},"
+                    for words in resolved]
+    phrase_lines[-1] = phrase_lines[-1].rstrip(",")
+    out += phrase_lines
+    out += [
+        "};",
+        "",
+        "// Spare letters lit one per minute past the 5-minute slot",
+        f"constexpr uint8_t LAYOUT_MINUTE_DOT_COUNT = {len(dots)};",
+        "",
+        "inline constexpr WordId LAYOUT_MINUTE_DOTS[LAYOUT_MINUTE_DOT_COUNT] = {"
+        + ", ".join(f"WordId::{word}" for word in dots) + "};",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def generate_python(layout, source, spans, resolved, dots):
+    out = [
+        f"# Generated by tools/generate_layout.py from {source}; do not edit.",
+        "",
+        f"NAME = {layout['name']!r}",
+        f"WIDTH = {layout['width']}",
+        f"HEIGHT = {layout['height']}",
+        "",
+        "GRID = [",
+    ]
+    out += [f"    {row!r}," for row in layout["grid"]]
+    out += [
+        "]",
+        "",
+        "# Inclusive LED ranges, in the order of the C++ WordId enum",
+        "WORDS_TO_LEDS = {",
+    ]
+    out += [f"    {name!r}: ({start}, {end})," for name, (start, end) in spans.items()]
+    out += [
+        "}",
+        "",
+        "# Words of every 5-minute slot of a 12-hour day, index hour % 12 * 12 + minute // 5",
+        "PHRASES = [",
+    ]
+    out += ["    (" + ", ".join(repr(word) for word in words) + ",)," for words in resolved]
+    out += [
+        "]",
+        "",
+        "# Spare letters lit one per minute past the 5-minute slot",
+        "MINUTE_DOTS = (" + ", ".join(repr(word) for word in dots) + ")",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def write_if_changed(path, content):
+    """Leaves an unchanged file alone so the build doesn't recompile everything."""
+    try:
+        with open(path, encoding="utf-8") as file:
+            if file.read() == content:
+                return False
+    except FileNotFoundError:
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w", encoding="utf-8") as file:
+        file.write(content)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile a word clock layout into C++ and Python tables.")
+    parser.add_argument("layout", help="Layout description, e.g. layouts/english.json")
+    parser.add_argument("--check", action="store_true", help="Fail if the generated files are out of date instead of writing them.")
+    parser.add_argument("--cpp-output", help="Write only the C++ tables, to this path instead of the source tree.")
+    args = parser.parse_args()
+
+    with open(args.layout, encoding="utf-8") as file:
+        layout = json.load(file)
+    source = os.path.relpath(os.path.abspath(args.layout), ROOT).replace(os.sep, "/")
+    try:
+        spans = word_spans(layout)
+        resolved = phrases(layout, spans)
+        dots = minute_dots(layout, spans, resolved)
+    except LayoutError as error:
+        sys.exit(f"{args.layout}: {error}")
+
+    if args.cpp_output:
+        outputs = {os.path.abspath(args.cpp_output): generate_cpp(layout, source, spans, resolved, dots)}
+    else:
+        outputs = {
+            CPP_OUTPUT: generate_cpp(layout, source, spans, resolved, dots),
+            PYTHON_OUTPUT: generate_python(layout, source, spans, resolved, dots),
+        }
+    for path, content in outputs.items():
+        if args.check:
+            with open(path, encoding="utf-8") as file:
+                if file.read() != content:
+                    sys.exit(f"{path} is out of date; run tools/generate_layout.py {args.layout}")
+        elif write_if_changed(path, content):
+            print(f"Generated {os.path.relpath(path, ROOT)} from {source}")
+
+
+if __name__ == "__main__":
+    main()
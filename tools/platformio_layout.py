@@ -0,0 +1,24 @@
+# PlatformIO pre-build script for the word layout tables (see platformio.ini).
+# The committed tables are only checked against their layout, never rewritten,
+# so builds leave the tree clean. Any other custom_layout is generated into the
+# build directory and included from there instead.
+import os
+import re
+import subprocess
+
+Import("env")
+
+root = os.path.normpath(os.path.join(env.subst("$PROJECT_DIR"), "..", ".."))
+generator = os.path.join(root, "tools", "generate_layout.py")
+layout = env.GetProjectOption("custom_layout", "english")
+source = "layouts/" + layout + ".json"
+
+with open(os.path.join(root, "esp", "wordclock", "src", "WordLayoutTables.h"), encoding="utf-8") as file:
+    committed = re.search(r"from (\S+);", file.readline())
+
+if committed and committed.group(1) == source:
+    subprocess.check_call([env.subst("$PYTHONEXE"), generator, "--check", os.path.join(root, source)])
+else:
+    tables = os.path.join(env.subst("$BUILD_DIR"), "layout", "WordLayoutTables.h")
+    subprocess.check_call([env.subst("$PYTHONEXE"), generator, "--cpp-output", tables, os.path.join(root, source)])
+    env.Append(CPPDEFINES=[("WORD_LAYOUT_TABLES", env.StringifyMacro(tables))])